@@ -267,6 +267,7 @@ CPP_TEST_CASES += \
 	rename2 \
 	rename3 \
 	rename4 \
+	rename_match \
 	rename_scope \
 	rename_strip_encoder \
 	restrict_cplusplus \
@@ -334,6 +335,7 @@ CPP_TEST_CASES += \
 	template_ns_enum \
 	template_ns_enum2 \
 	template_ns_inherit \
+	template_ns_same_name \
 	template_ns_scope \
 	template_partial_arg \
 	template_qualifier \
@@ -380,6 +382,7 @@ CPP_TEST_CASES += \
 	typename \
 	types_directive \
 	union_scope \
+	usage_manifest \
 	using1 \
 	using2 \
 	using_composition \
@@ -475,6 +478,7 @@ MULTI_CPP_TEST_CASES += \
 
 # Custom tests - tests with additional commandline options
 wallkw.cpptest: SWIGOPT += -Wallkw
+usage_manifest.cpptest: SWIGOPT += -manifest $(top_srcdir)/$(EXAMPLES)/$(TEST_SUITE)/usage_manifest.txt
 
 
 NOT_BROKEN_TEST_CASES =	$(CPP_TEST_CASES:=.cpptest) \
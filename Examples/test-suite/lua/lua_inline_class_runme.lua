@@ -0,0 +1,39 @@
+require("import")	-- the import fn
+import("lua_inline_class")	-- import code
+lic=lua_inline_class    -- alias
+
+a=lic.Vector3(1,0,0)
+b=lic.Vector3(0,1,0)
+assert(lic.live_vectors() == 2)
+
+-- returned by value, so held inline in the userdata
+c=lic.cross(a,b)
+assert(swig_type(c)=='Vector3 *')
+assert(c.x==0 and c.y==0 and c.z==1)
+assert(lic.live_vectors() == 3)
+
+d=c:add(a)
+assert(d.x==1 and d.y==0 and d.z==1)
+assert(d:dot(c)==1)
+c.x=2
+assert(c.x==2)
+assert(lic.live_vectors() == 4)
+
+-- cannot give an inline object away to C++
+assert(pcall(lic.take,c)==false)
+assert(c.x==2)
+
+-- but normally allocated ones can be
+lic.take(lic.Vector3(1,2,3))
+assert(lic.live_vectors() == 4)
+
+-- the inline objects are destroyed in place when collected
+c=nil
+d=nil
+collectgarbage()
+assert(lic.live_vectors() == 2)
+
+a=nil
+b=nil
+collectgarbage()
+assert(lic.live_vectors() == 0)
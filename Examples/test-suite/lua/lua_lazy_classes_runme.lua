@@ -0,0 +1,22 @@
+require("import")	-- the import fn
+import("lua_lazy_classes")	-- import code
+llc=lua_lazy_classes    -- alias
+
+-- returned from a function before the class or its bases are used
+c=llc.make_child()
+assert(swig_type(c)=='Child *')
+assert(c:child()==3 and c:parent()==2 and c:grandparent()==1)
+assert(c:name()==3)
+assert(c.value==2)
+c.value=5
+assert(c.value==5)
+
+-- a base class used after its derived class
+p=llc.Parent()
+assert(p:parent()==2 and p:grandparent()==1 and p:name()==2)
+assert(p.child==nil)
+assert(llc.call_name(p)==2 and llc.call_name(c)==3)
+
+-- a class without a constructor
+a=llc.make_abstract()
+assert(a:abstract()==4)
@@ -0,0 +1,29 @@
+/* Tests %lua_inline_class, which holds objects returned by value inline in the Lua userdata */
+%module lua_inline_class
+
+%lua_inline_class(Vector3);
+%apply SWIGTYPE* DISOWN { Vector3* disown };
+
+%inline %{
+struct Vector3 {
+  static int live;
+  double x, y, z;
+  Vector3(double x = 0, double y = 0, double z = 0) : x(x), y(y), z(z) { ++live; }
+  Vector3(const Vector3& v) : x(v.x), y(v.y), z(v.z) { ++live; }
+  ~Vector3() { --live; }
+  Vector3 add(const Vector3& v) const { return Vector3(x + v.x, y + v.y, z + v.z); }
+  double dot(const Vector3& v) const { return x * v.x + y * v.y + z * v.z; }
+};
+
+int live_vectors() { return Vector3::live; }
+
+Vector3 cross(const Vector3& a, const Vector3& b) {
+  return Vector3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+void take(Vector3* disown) { delete disown; }
+%}
+
+%{
+int Vector3::live = 0;
+%}
@@ -0,0 +1,41 @@
+/* Tests SWIGLUA_LAZY_CLASSES, where the class metatables are only created when the first object of a class is pushed */
+%module lua_lazy_classes
+
+%begin %{
+#define SWIGLUA_LAZY_CLASSES
+%}
+
+%inline %{
+struct Grandparent {
+  virtual ~Grandparent() {}
+  int grandparent() const { return 1; }
+  virtual int name() const { return 1; }
+};
+
+struct Parent : Grandparent {
+  int value;
+  Parent() : value(2) {}
+  int parent() const { return 2; }
+  virtual int name() const { return 2; }
+};
+
+struct Child : Parent {
+  int child() const { return 3; }
+  virtual int name() const { return 3; }
+};
+
+class Abstract {
+public:
+  virtual ~Abstract() {}
+  virtual int abstract() const = 0;
+};
+
+class Concrete : public Abstract {
+public:
+  virtual int abstract() const { return 4; }
+};
+
+Child *make_child() { return new Child(); }
+Abstract *make_abstract() { static Concrete c; return &c; }
+int call_name(const Grandparent &g) { return g.name(); }
+%}
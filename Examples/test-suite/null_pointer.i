@@ -6,5 +6,9 @@
   bool func(A* a) {
     return !a;
   }
+
+  A* getnull() {
+    return 0;
+  }
 }
 
@@ -0,0 +1,8 @@
+use strict;
+use warnings;
+use Test::More tests => 4;
+BEGIN { use_ok('null_pointer') }
+require_ok('null_pointer');
+
+ok(null_pointer::func(undef), "undef is a null pointer");
+ok(!defined(null_pointer::getnull()), "a null pointer is undef");
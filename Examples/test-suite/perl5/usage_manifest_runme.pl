@@ -0,0 +1,38 @@
+use strict;
+use warnings;
+use Test::More tests => 20;
+BEGIN { use_ok('usage_manifest') }
+require_ok('usage_manifest');
+
+# adapted from ../python/usage_manifest_runme.py
+
+my $d = usage_manifest::Derived->new();
+is($d->derived_used(), 3, "derived_used");
+is($d->base_used(), 1, "base_used");
+is($d->overloaded(1), 5, "overloaded int");
+is($d->overloaded(1.5), 6, "overloaded double");
+ok(!$d->can('derived_unused') && !$d->can('base_unused'), "unused members not wrapped");
+
+my $w = usage_manifest::Whole->new();
+is($w->one() + $w->two(), 3, "Whole");
+
+is($usage_manifest::GREEN, 1, "listed enum item");
+is($usage_manifest::RED, 0, "enum kept with its listed item");
+
+my $b = usage_manifest::make_unused();
+is($b->base_used(), 1, "make_unused");
+
+is($usage_manifest::used_variable, 42, "used_variable");
+
+my $p = usage_manifest::make_point();
+isa_ok($p, 'usage_manifest::Point');
+isa_ok($p, 'usage_manifest::PointBase');
+
+my $e = usage_manifest::Extended->new();
+is($e->used(), 8, "Extended");
+ok(!$e->can('ext'), "unused %extend member not wrapped");
+
+ok(!usage_manifest::Unused->can('new'), "Unused not wrapped");
+ok(!usage_manifest->can('unused_function'), "unused_function not wrapped");
+ok(!defined $usage_manifest::SQUARE, "unused enum not wrapped");
+ok(!defined $usage_manifest::SMALL, "enum of unused member not wrapped");
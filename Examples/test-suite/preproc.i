@@ -342,3 +342,14 @@ int method(struct TypeNameTraits tnt) {
   return tnt.val;
 }
 %}
+
+/* ## before __VA_ARGS__ removes the preceding comma when there are no variable arguments */
+#define ELIDE_COMMA_ARGS(first, ...) (first, ##__VA_ARGS__)
+
+%{
+int elide_comma(int a) { return a; }
+int elide_comma_vargs(int a, int b) { return a + b; }
+%}
+
+int elide_comma ELIDE_COMMA_ARGS(int a);
+int elide_comma_vargs ELIDE_COMMA_ARGS(int a, int b);
@@ -12,3 +12,9 @@ if preproc.defined != 1:
 if 2*preproc.one != preproc.two:
   raise RuntimeError
 
+
+if preproc.elide_comma(1) != 1:
+  raise RuntimeError
+
+if preproc.elide_comma_vargs(1, 2) != 3:
+  raise RuntimeError
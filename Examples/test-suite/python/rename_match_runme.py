@@ -0,0 +1,19 @@
+import rename_match
+
+if rename_match.NamedSecond() != 1:
+    raise RuntimeError
+
+if rename_match.BYNAME() != 2:
+    raise RuntimeError
+
+if rename_match.FirstNamed() != 3:
+    raise RuntimeError
+
+if rename_match.PlainBar() != 4:
+    raise RuntimeError
+
+if rename_match.skipped() != 5:
+    raise RuntimeError
+
+if rename_match.ScopedBar() != 6:
+    raise RuntimeError
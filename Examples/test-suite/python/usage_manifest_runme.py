@@ -0,0 +1,39 @@
+import usage_manifest
+
+d = usage_manifest.Derived()
+if d.derived_used() != 3:
+  raise RuntimeError, "derived_used"
+if d.base_used() != 1:
+  raise RuntimeError, "base_used"
+if d.overloaded(1) != 5 or d.overloaded(1.5) != 6:
+  raise RuntimeError, "overloaded"
+if hasattr(d, "derived_unused") or hasattr(d, "base_unused"):
+  raise RuntimeError, "unused member wrapped"
+
+w = usage_manifest.Whole()
+if w.one() != 1 or w.two() != 2:
+  raise RuntimeError, "Whole"
+
+if usage_manifest.RED != 0 or usage_manifest.GREEN != 1:
+  raise RuntimeError, "Color"
+
+b = usage_manifest.make_unused()
+if b.base_used() != 1:
+  raise RuntimeError, "make_unused"
+
+if usage_manifest.cvar.used_variable != 42:
+  raise RuntimeError, "used_variable"
+
+p = usage_manifest.make_point()
+if not isinstance(p, usage_manifest.Point) or not isinstance(p, usage_manifest.PointBase):
+  raise RuntimeError, "make_point"
+
+e = usage_manifest.Extended()
+if e.used() != 8:
+  raise RuntimeError, "Extended"
+if hasattr(e, "ext"):
+  raise RuntimeError, "unused %extend member wrapped"
+
+for name in ["Unused", "unused_function", "SQUARE", "CIRCLE", "SMALL", "LARGE"]:
+  if hasattr(usage_manifest, name):
+    raise RuntimeError, name + " wrapped"
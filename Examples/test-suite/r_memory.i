@@ -0,0 +1,37 @@
+/* Tests that read only arrays are passed without a copy and that objects owned by R are deleted by the garbage collector */
+%module r_memory
+
+%apply SWIGTYPE *DISOWN { Block *disown };
+%newobject make_block;
+
+%inline %{
+double total(const double *v, int n) {
+  double s = 0;
+  for (int i = 0; i < n; i++) s += v[i];
+  return s;
+}
+int last(const int v[3]) { return v[2]; }
+
+const double *seen = 0;
+const double *address(const double *v) { seen = v; return v; }
+bool same_address(const double *v) { return v == seen; }
+
+struct Block {
+  static int live;
+  Block() { ++live; }
+  Block(const Block&) { ++live; }
+  ~Block() { --live; }
+};
+
+int live_blocks() { return Block::live; }
+Block *make_block() { return new Block(); }
+Block copy_block(const Block& b) { return b; }
+
+Block *kept = 0;
+void take(Block *disown) { kept = disown; }
+void drop() { delete kept; kept = 0; }
+%}
+
+%{
+int Block::live = 0;
+%}
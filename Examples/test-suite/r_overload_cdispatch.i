@@ -0,0 +1,24 @@
+/* Tests the overload dispatch routines generated in C with -cdispatch */
+%module r_overload_cdispatch
+
+%inline %{
+struct Foo {
+  int get(int i) { return i; }
+  double get(double d) { return 2 * d; }
+};
+struct Bar : Foo {};
+
+const char *pick() { return "none"; }
+const char *pick(int i) { return "int"; }
+const char *pick(double d) { return "double"; }
+const char *pick(const char *s) { return "char"; }
+const char *pick(Foo *f) { return "Foo"; }
+const char *pick(int i, int j) { return "int,int"; }
+
+Foo *make(int) { return new Foo(); }
+Foo *make(Foo *f) { return f; }
+
+enum Color { RED, GREEN };
+const char *paint(Color c) { return "Color"; }
+const char *paint(Foo *f) { return "Foo"; }
+%}
@@ -0,0 +1,26 @@
+/* Tests %feature("vectorize"), which makes functions of scalar arithmetic types loop over R vectors */
+%module r_vectorize
+
+%feature("vectorize") scale;
+%feature("vectorize") add;
+%feature("vectorize") is_even;
+%feature("vectorize") bump;
+%feature("vectorize") halve;
+%feature("vectorize") shift;
+
+/* A user in typemap must not be bypassed by the vectorized conversion */
+%typemap(in) int by %{ $1 = INTEGER($input)[0] + 100; %}
+
+%inline %{
+double scale(double x, int factor) { return x * factor; }
+int add(int a, int b) { return a + b; }
+bool is_even(long n) { return n % 2 == 0; }
+
+int bumped = 0;
+void bump(int n) { bumped += n; }
+
+/* Not vectorized, so only the first element is used */
+int halve(int *n) { return *n / 2; }
+int twice(int n) { return 2 * n; }
+int shift(int n, int by) { return n + by; }
+%}
@@ -0,0 +1,30 @@
+%module rename_match
+
+/* The last matching %rename takes precedence, whether it is looked up by
+   the declaration name or applies to any name */
+
+%rename(NamedFirst, %$isfunction) named;
+%rename(NamedSecond, %$isfunction) named;
+
+%rename(ByName, %$isfunction) byname;
+%rename("%(upper)s", match$name="byname") "";
+
+%rename("%(upper)s", match$name="first") "";
+%rename(FirstNamed, %$isfunction) first;
+
+%rename(PlainBar, %$isfunction) bar;
+%rename(ScopedBar, fullname=1, %$isfunction) "Space::bar";
+
+%rename(NotAVariable, %$isvariable) skipped;
+
+%inline %{
+int named() { return 1; }
+int byname() { return 2; }
+int first() { return 3; }
+int bar() { return 4; }
+int skipped() { return 5; }
+
+namespace Space {
+  int bar() { return 6; }
+}
+%}
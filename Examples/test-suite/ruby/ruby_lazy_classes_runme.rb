@@ -0,0 +1,44 @@
+#!/usr/bin/env ruby
+#
+# Classes of a module built with SWIGRUBY_LAZY_CLASSES are only defined
+# when they are first used.
+#
+
+require 'swig_assert'
+
+require 'ruby_lazy_classes'
+
+def test_defined(name, expected)
+  if Ruby_lazy_classes.constants.include?(name) != expected
+    raise "#{name} should #{expected ? '' : 'not '}be defined"
+  end
+end
+
+test_defined(:Derived, false)
+
+# Returning an object defines its class
+b = Ruby_lazy_classes.make_derived
+raise "wrong class #{b.class}" unless b.class == Ruby_lazy_classes::Base
+test_defined(:Base, true)
+raise "wrong value" unless Ruby_lazy_classes.call_value(b) == 2
+
+# Naming a derived class defines it along with its base
+d = Ruby_lazy_classes::Derived.new
+raise "wrong superclass" unless Ruby_lazy_classes::Derived.superclass == Ruby_lazy_classes::Base
+raise "wrong value" unless d.value == 2
+raise "wrong value" unless Ruby_lazy_classes.call_value(d) == 2
+
+# Pointer classes are defined when first used
+p = Ruby_lazy_classes.int_pointer
+raise "wrong class #{p.class}" unless p.class.name == "SWIG::TYPE_p_int"
+
+# Classes are also defined when named through an including module
+include Ruby_lazy_classes
+test_defined(:Unused, false)
+raise "wrong class" unless Unused.new.class == Ruby_lazy_classes::Unused
+
+begin
+  Ruby_lazy_classes::NoSuchClass
+  raise "NameError not raised"
+rescue NameError
+end
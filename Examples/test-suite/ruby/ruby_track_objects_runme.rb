@@ -115,3 +115,18 @@ end
 
 
 
+
+# A freed object of a class without a destructor is no longer returned
+def get_singles
+  1000.times { Ruby_track_objects::Single.get }
+  nil
+end
+
+get_singles
+GC.start
+100000.times { "x" * 10 }
+single = Ruby_track_objects::Single.get
+
+if single.class != Ruby_track_objects::Single
+  raise RuntimeError, 'Single should have a Single class'
+end
@@ -0,0 +1,25 @@
+/* Tests SWIGRUBY_LAZY_CLASSES, where the Ruby classes are only defined when they are first used */
+%module ruby_lazy_classes
+
+%begin %{
+#define SWIGRUBY_LAZY_CLASSES
+%}
+
+%inline %{
+struct Base {
+  virtual ~Base() {}
+  virtual int value() const { return 1; }
+};
+
+struct Derived : Base {
+  int value() const { return 2; }
+};
+
+struct Unused {
+  int x;
+};
+
+Base *make_derived() { static Derived d; return &d; }
+int call_value(const Base *b) { return b->value(); }
+int *int_pointer() { static int i = 3; return &i; }
+%}
@@ -22,6 +22,9 @@
 %trackobjects ItemA;
 %trackobjects ItemB;
 
+%trackobjects Single;
+%newobject Single::get;
+
 %inline %{
 
 class Foo
@@ -122,4 +125,17 @@ public:
 	}
 };
 
+/* Has no destructor to wrap, so the Ruby objects owning it must still
+   remove their tracking when they are freed */
+class Single
+{
+	~Single() {}
+public:
+	static Single* get()
+	{
+		static Single* single = new Single;
+		return single;
+	}
+};
+
 %}
@@ -0,0 +1,38 @@
+
+if [ catch { load ./multiple_inheritance[info sharedlibextension] multiple_inheritance} err_msg ] {
+	puts stderr "Could not load shared object:\n$err_msg"
+}
+
+proc check {result expected} {
+  if {$result != $expected} {
+    puts stderr "got $result, expected $expected"
+    exit 1
+  }
+}
+
+# Methods are found in the class and in each of its base classes,
+# also when the same method name is used with objects of another class
+FooBarSpam fbs
+FooBar fb
+Foo f
+for {set i 0} {$i < 2} {incr i} {
+  foreach method {foo bar} expected {2 1} {
+    check [fbs $method] $expected
+    check [fb $method] $expected
+  }
+  check [fbs spam 0] 100
+  check [fbs fooBarSpam] 4
+  check [fb fooBar] 3
+  check [f foo] 2
+}
+
+if [ catch { fb spam 0 } ] {
+} else {
+  puts stderr "spam is not a method of FooBar"
+  exit 1
+}
+if [ catch { f bar } ] {
+} else {
+  puts stderr "bar is not a method of Foo"
+  exit 1
+}
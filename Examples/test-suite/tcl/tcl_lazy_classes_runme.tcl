@@ -0,0 +1,41 @@
+
+if [ catch { load ./tcl_lazy_classes[info sharedlibextension] tcl_lazy_classes} err_msg ] {
+	puts stderr "Could not load shared object:\n$err_msg"
+}
+
+proc check {result expected} {
+  if {$result != $expected} {
+    puts stderr "got $result, expected $expected"
+    exit 1
+  }
+}
+
+# Only the class commands are created when the module is loaded
+check [info commands Derived_value] ""
+check [info commands Unused_y_get] ""
+check [info commands Derived] Derived
+
+# The member commands are created when one of them is first called
+set d [new_Derived]
+check [info commands Derived_value] Derived_value
+check [Derived_value $d] 2
+Derived_x_set $d 5
+check [Derived_x_get $d] 5
+check [call_value $d] 2
+delete_Derived $d
+
+# The object interface does not need the member commands
+Base b
+check [b value] 1
+check [info commands Base_value] ""
+set p [make_derived]
+check [Base_value $p] 2
+
+check [info commands Unused_y_get] ""
+
+# Other unknown commands still fail
+if {![catch {no_such_command} err_msg]} {
+  puts stderr "no_such_command did not fail"
+  exit 1
+}
+check [string match "invalid command name*" $err_msg] 1
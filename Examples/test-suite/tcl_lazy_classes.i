@@ -0,0 +1,25 @@
+/* Tests SWIGTCL_LAZY_CLASSES, where the commands of the class members are only created when one of them is first called */
+%module tcl_lazy_classes
+
+%begin %{
+#define SWIGTCL_LAZY_CLASSES
+%}
+
+%inline %{
+struct Base {
+  virtual ~Base() {}
+  virtual int value() const { return 1; }
+};
+
+struct Derived : Base {
+  int value() const { return 2; }
+  int x;
+};
+
+struct Unused {
+  int y;
+};
+
+Base *make_derived() { static Derived d; return &d; }
+int call_value(const Base *b) { return b->value(); }
+%}
@@ -0,0 +1,20 @@
+// Tests instantiating templates with the same name and arguments in different namespaces
+
+%module template_ns_same_name
+
+%inline %{
+namespace ns1 {
+  template<class T> struct Foo {
+    int one() { return 1; }
+  };
+}
+
+namespace ns2 {
+  template<class T> struct Foo {
+    int two() { return 2; }
+  };
+}
+%}
+
+%template(Foo1) ns1::Foo<int>;
+%template(Foo2) ns2::Foo<int>;
@@ -0,0 +1,57 @@
+/* Tests the -manifest option.  Only the declarations named in usage_manifest.txt are wrapped. */
+%module usage_manifest
+
+%inline %{
+namespace Space {
+  struct Base {
+    virtual ~Base() {}
+    int base_used() const { return 1; }
+    int base_unused() const { return 2; }
+  };
+
+  struct Derived : Base {
+    int derived_used() const { return 3; }
+    int derived_unused() const { return 4; }
+    int overloaded(int) const { return 5; }
+    int overloaded(double) const { return 6; }
+  };
+
+  struct Unused : Derived {
+    int unused() const { return 7; }
+  };
+
+  struct Whole {
+    int one() const { return 1; }
+    int two() const { return 2; }
+  };
+
+  enum Color { RED, GREEN };
+  enum Shape { SQUARE, CIRCLE };
+  enum Size { SMALL, LARGE };
+
+  struct PointBase {
+    int x;
+  };
+
+  struct Point : PointBase {
+    Size size() const { return LARGE; }
+  };
+
+  struct Extended {
+    int used() const { return 8; }
+  };
+}
+%}
+
+%extend Space::Extended {
+  int ext() const { return 9; }
+}
+
+%inline %{
+Space::Point make_point() { Space::Point p; p.x = 10; return p; }
+
+Space::Base *make_unused() { return new Space::Unused(); }
+int unused_function() { return 0; }
+int used_variable = 42;
+int unused_variable = 0;
+%}
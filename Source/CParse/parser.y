@@ -3626,6 +3626,10 @@ cpp_template_decl : TEMPLATE LESSTHAN template_parms GREATERTHAN { template_para
 		      Node *ntop = $6;
 		      Node *ni = ntop;
 		      SwigType *ntype = ni ? nodeType(ni) : 0;
+
+		      /* a new template or specialization may be the one to use */
+		      Swig_cparse_template_reset();
+
 		      while (ni && Strcmp(ntype,"namespace") == 0) {
 			sti = Getattr(ni,"symtab");
 			ni = firstChild(ni);
@@ -422,6 +422,22 @@ int Swig_cparse_template_expand(Node *n, String *rname, ParmList *tparms, Symtab
   return 0;
 }
 
+/* -----------------------------------------------------------------------------
+ * Swig_cparse_template_reset()
+ *
+ * The templates located are remembered by the template name with the
+ * default, qualified arguments and the scope, as the same instantiations
+ * are located over and over again. Declaring a template or a specialization
+ * can change the template to use, so it forgets them all.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *template_located = 0;
+
+void Swig_cparse_template_reset() {
+  Delete(template_located);
+  template_located = 0;
+}
+
 /* -----------------------------------------------------------------------------
  * template_locate()
  *
@@ -431,6 +447,7 @@ int Swig_cparse_template_expand(Node *n, String *rname, ParmList *tparms, Symtab
 static Node *template_locate(String *name, Parm *tparms, Symtab *tscope) {
   Node *n;
   String *tname, *rname = 0;
+  String *located;
   Node *templ;
   List *mpartials = 0;
   Parm *p;
@@ -473,6 +490,24 @@ static Node *template_locate(String *name, Parm *tparms, Symtab *tscope) {
     Printf(stdout, "\n%s:%d: template_debug: Searching for %s\n", cparse_file, cparse_line, tname);
   }
 
+  if (!template_located)
+    template_located = NewHash();
+  /* The exact and partial specializations are searched for in the current
+     scope, which the %template directive sets to the scope of a qualified
+     name, so the key is that scope and the generic template, not just the
+     unqualified name. */
+  located = NewStringf("%p|%p|%p|%s", Swig_symbol_current(), tscope, templ, tname);
+  n = Getattr(template_located, located);
+  if (n) {
+    if (template_debug) {
+      Printf(stdout, "    found: '%s' (located before)\n", tname);
+    }
+    Delete(located);
+    Delete(tname);
+    Delete(parms);
+    return n;
+  }
+
   /* Search for an exact specialization.
      Example: template<> class name<int> { ... } */
   {
@@ -501,6 +536,7 @@ static Node *template_locate(String *name, Parm *tparms, Symtab *tscope) {
 	goto success;		/* Previously wrapped by a template return that */
       }
       Swig_error(cparse_file, cparse_line, "'%s' is not defined as a template. (%s)\n", name, nodeType(n));
+      Delete(located);
       Delete(tname);
       Delete(parms);
       return 0;			/* Found a match, but it's not a template of any kind. */
@@ -592,6 +628,8 @@ static Node *template_locate(String *name, Parm *tparms, Symtab *tscope) {
 	Swig_warning(WARN_PARSE_TEMPLATE_AMBIG, cparse_file, cparse_line, "Instantiation of template '%s' is ambiguous,\n", SwigType_namestr(tname));
 	Swig_warning(WARN_PARSE_TEMPLATE_AMBIG, Getfile(n), Getline(n), "  instantiation '%s' is used.\n", SwigType_namestr(Getattr(n, "name")));
       }
+      /* not remembered, so that the warning is given for each instantiation */
+      Clear(located);
     }
   }
 
@@ -608,6 +646,9 @@ static Node *template_locate(String *name, Parm *tparms, Symtab *tscope) {
     }
   }
 success:
+  if (n && Len(located))
+    Setattr(template_located, located, n);
+  Delete(located);
   Delete(tname);
   Delete(rname);
   Delete(mpartials);
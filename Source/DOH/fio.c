@@ -38,6 +38,34 @@ static int Writen(DOH *out, void *buffer, int len) {
   return len;
 }
 
+/* -----------------------------------------------------------------------------
+ * Writetext()
+ *
+ * Writes a run of literal text.  Characters written one at a time with Putc()
+ * are counted by a string's line number, so the newlines in the run are added
+ * in the same way.
+ * ----------------------------------------------------------------------------- */
+
+static int Writetext(DOH *out, const char *text, int len) {
+  if (len == 1) {
+    Putc(*text, out);
+    return 1;
+  }
+  if (Writen(out, (void *) text, len) < 0)
+    return -1;
+  if (DohCheck(out) && DohIsString(out)) {
+    int nlines = 0;
+    const char *c = text;
+    while ((c = (const char *) memchr(c, '\n', len - (c - text)))) {
+      nlines++;
+      c++;
+    }
+    if (nlines)
+      Setline(out, Getline(out) + nlines);
+  }
+  return len;
+}
+
 /* -----------------------------------------------------------------------------
  * DohEncoding()
  *
@@ -94,8 +122,10 @@ static DOH *encode(char *name, DOH *s) {
  *       %(encoder)* - Filters the output through an encoding function registered
  *                     with DohEncoder().
  *
- * Note: This function is not particularly memory efficient with large strings.
- * It's better to use Dump() or some other method instead.
+ * Literal text between the formatting codes is written out as a block and a
+ * plain %s is copied straight to the output without going through sprintf().
+ * Other formatting codes still use a temporary buffer, so Dump() remains the
+ * better choice for copying large strings.
  * ----------------------------------------------------------------------------- */
 
 int DohvPrintf(DOH *so, const char *format, va_list ap) {
@@ -124,8 +154,12 @@ int DohvPrintf(DOH *so, const char *format, va_list ap) {
     switch (state) {
     case 0:			/* Ordinary text */
       if (*p != '%') {
-	Putc(*p, so);
-	nbytes++;
+	const char *e = strchr(p, '%');
+	int len = e ? (int) (e - p) : (int) strlen(p);
+	if (Writetext(so, p, len) < 0)
+	  return -1;
+	nbytes += len;
+	p += len - 1;
       } else {
 	fmt = newformat;
 	widthval = 0;
@@ -289,7 +323,16 @@ int DohvPrintf(DOH *so, const char *format, va_list ap) {
 	DOH *Sval;
 	DOH *enc = 0;
 	doh = va_arg(ap, DOH *);
-	if (DohCheck(doh)) {
+	if ((fmt == newformat + 1) && !encoder[0] && (doh != so) && (!DohCheck(doh) || DohIsString(doh))) {
+	  /* Plain %s of a string.  No need to format anything */
+	  const char *c = doh ? (DohCheck(doh) ? (const char *) Data(doh) : (const char *) doh) : "";
+	  int len = (int) strlen(c);
+	  if (Writen(so, (void *) c, len) < 0)
+	    return -1;
+	  nbytes += len;
+	  if ((*p == 'S') && DohCheck(doh))
+	    Delete(doh);
+	} else if (DohCheck(doh)) {
 	  /* Is a DOH object. */
 	  if (DohIsString(doh)) {
 	    Sval = doh;
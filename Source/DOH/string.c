@@ -425,9 +425,12 @@ static int String_write(DOH *so, void *buffer, int len) {
     s->sp = s->len;
   newlen = s->sp + len + 1;
   if (newlen > s->maxsize) {
-    s->str = (char *) DohRealloc(s->str, newlen);
+    int newmaxsize = 2 * s->maxsize;
+    if (newlen > newmaxsize)
+      newmaxsize = newlen;
+    s->str = (char *) DohRealloc(s->str, newmaxsize);
     assert(s->str);
-    s->maxsize = newlen;
+    s->maxsize = newmaxsize;
     s->len = s->sp + len;
   }
   if ((s->sp + len) > s->len)
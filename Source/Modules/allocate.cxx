@@ -58,6 +58,44 @@ extern "C" {
 class Allocate:public Dispatcher {
   Node *inclass;
   int extendmode;
+  Hash *class_members;		/* Members of the classes by name, for each class already searched */
+
+  /* Returns the members of class b, including %extend and using declaration
+   * members, indexed by name. Each name has the list of members with that
+   * name in declaration order. The index is built the first time a class is
+   * searched as a base, as the names of the members do not change here. */
+  Hash *members_by_name(Node *b) {
+    String *key = NewStringf("%p", b);
+    Hash *members = Getattr(class_members, key);
+    if (!members) {
+      members = NewHash();
+      for (Node *c = firstChild(b); c; c = nextSibling(c)) {
+	if ((Strcmp(nodeType(c), "extend") == 0) || (Strcmp(nodeType(c), "using") == 0)) {
+	  for (Node *e = firstChild(c); e; e = nextSibling(e))
+	    add_member(members, e);
+	} else {
+	  add_member(members, c);
+	}
+      }
+      Setattr(class_members, key, members);
+      Delete(members);
+    }
+    Delete(key);
+    return members;
+  }
+
+  void add_member(Hash *members, Node *c) {
+    String *name = Getattr(c, "name");
+    if (!name)
+      return;
+    List *named = Getattr(members, name);
+    if (!named) {
+      named = NewList();
+      Setattr(members, name, named);
+      Delete(named);
+    }
+    Append(named, c);
+  }
 
   /* Checks if a function, n, is the same as any in the base class, ie if the method is polymorphic.
    * Also checks for methods which will be hidden (ie a base has an identical non-virtual method).
@@ -72,42 +110,23 @@ class Allocate:public Dispatcher {
        return 0;
 
     String *name = Getattr(n, "name");
+    if (!name)
+       return 0;
+
     String *this_type = Getattr(n, "type");
     String *resolved_decl = SwigType_typedef_resolve_all(this_decl);
 
     // Search all base classes for methods with same signature
     for (int i = 0; i < Len(bases); i++) {
       Node *b = Getitem(bases, i);
-      Node *base = firstChild(b);
-      while (base) {
-	if (Strcmp(nodeType(base), "extend") == 0) {
-	  // Loop through all the %extend methods
-	  Node *extend = firstChild(base);
-	  while (extend) {
-	    if (function_is_defined_in_bases_seek(n, b, extend, this_decl, name, this_type, resolved_decl)) {
-	      Delete(resolved_decl);
-	      return 1;
-	    }
-	    extend = nextSibling(extend);
-	  }
-	} else if (Strcmp(nodeType(base), "using") == 0) {
-	  // Loop through all the using declaration methods
-	  Node *usingdecl = firstChild(base);
-	  while (usingdecl) {
-	    if (function_is_defined_in_bases_seek(n, b, usingdecl, this_decl, name, this_type, resolved_decl)) {
-	      Delete(resolved_decl);
-	      return 1;
-	    }
-	    usingdecl = nextSibling(usingdecl);
-	  }
-	} else {
-	  // normal methods
-	  if (function_is_defined_in_bases_seek(n, b, base, this_decl, name, this_type, resolved_decl)) {
+      List *named = Getattr(members_by_name(b), name);
+      if (named) {
+	for (int k = 0; k < Len(named); k++) {
+	  if (function_is_defined_in_bases_seek(n, b, Getitem(named, k), this_decl, name, this_type, resolved_decl)) {
 	    Delete(resolved_decl);
 	    return 1;
 	  }
 	}
-	base = nextSibling(base);
       }
     }
     Delete(resolved_decl);
@@ -537,7 +556,11 @@ class Allocate:public Dispatcher {
 
 public:
 Allocate():
-  inclass(NULL), extendmode(0) {
+  inclass(NULL), extendmode(0), class_members(NewHash()) {
+  }
+
+  ~Allocate() {
+    Delete(class_members);
   }
 
   virtual int top(Node *n) {
@@ -3408,6 +3408,16 @@ String *Language::defaultExternalRuntimeFilename() {
   return 0;
 }
 
+/* -----------------------------------------------------------------------------
+ * Language::externalRuntimeInclude()
+ * Language modules whose runtime #includes the -external-runtime header in place
+ * of the runtime code when SWIG_NORUNTIME is defined should return true.
+ * ----------------------------------------------------------------------------- */
+
+int Language::externalRuntimeInclude() {
+  return 0;
+}
+
 /* -----------------------------------------------------------------------------
  * Language::replaceSpecialVariables()
  * Language modules should implement this if special variables are to be handled
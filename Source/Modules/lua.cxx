@@ -1167,6 +1167,10 @@ public:
   String *defaultExternalRuntimeFilename() {
     return NewString("swigluarun.h");
   }
+
+  int externalRuntimeInclude() {
+    return 1;
+  }
   
   /* ---------------------------------------------------------------------
    * helpers
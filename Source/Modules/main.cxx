@@ -61,6 +61,7 @@ static const char *usage1 = (const char *) "\
      -cpperraswarn   - Treat the preprocessor #error statement as #warning (default)\n\
      -copyright      - Display copyright notices\n\
      -debug-classes  - Display information about the classes found in the interface\n\
+     -debug-features - Display statistics about the %feature lookups\n\
      -debug-module <n>- Display module parse tree at stages 1-4, <n> is a csv list of stages\n\
      -debug-tags     - Display information about the tags found in the interface\n\
      -debug-template - Display information for debugging templates\n\
@@ -93,6 +94,7 @@ static const char *usage2 = (const char *) "\
      -l<ifile>       - Include SWIG library file <ifile>\n\
      -macroerrors    - Report errors inside macros\n\
      -makedefault    - Create default constructors/destructors (the default)\n\
+     -manifest <file>- Only wrap the declarations listed in the usage manifest <file>\n\
      -M              - List all dependencies\n\
      -MD             - Is equivalent to `-M -MF <file>', except `-E' is not implied\n\
      -MF <file>      - Generate dependencies into <file> and continue generating wrappers\n\
@@ -109,6 +111,9 @@ static const char *usage2 = (const char *) "\
      -noexcept       - Do not wrap exception specifiers\n\
      -nofastdispatch - Disable fast dispatch mode (default)\n\
      -nopreprocess   - Skip the preprocessor step\n\
+     -noruntime      - Do not include the SWIG runtime in the wrapper code, but #include\n\
+                       the header generated with -external-runtime instead\n\
+                       (Lua, Octave, Perl, Python, Ruby and Tcl only)\n\
 ";
 
 static const char *usage3 = (const char *) "\
@@ -173,6 +178,8 @@ static int werror = 0;
 static int depend = 0;
 static int depend_only = 0;
 static int memory_debug = 0;
+static int features_debug = 0;
+static String *manifest_file = 0;
 static int allkw = 0;
 static DOH *libfiles = 0;
 static DOH *cpps = 0;
@@ -294,6 +301,15 @@ void SWIG_library_directory(const char *subdirectory) {
   LangSubDir = NewString(subdirectory);
 }
 
+/* Returns true if the file was read from the SWIG library */
+int SWIG_library_file(const_String_or_char_ptr filename) {
+  if (!filename)
+    return 0;
+  if (Strncmp(filename, SwigLib, Len(SwigLib)) == 0)
+    return 1;
+  return SwigLibWin && Strncmp(filename, SwigLibWin, Len(SwigLibWin)) == 0;
+}
+
 // Returns the directory for generating language specific files (non C/C++ files)
 const String *SWIG_output_directory() {
   assert(outdir);
@@ -380,6 +396,8 @@ static void SWIG_dump_runtime() {
 
   Swig_banner(runtime);
   Printf(runtime, "\n");
+  Printf(runtime, "#ifndef SWIG_EXTERNAL_RUNTIME\n");
+  Printf(runtime, "#define SWIG_EXTERNAL_RUNTIME\n\n");
 
   s = Swig_include_sys("swiglabels.swg");
   if (!s) {
@@ -399,13 +417,6 @@ static void SWIG_dump_runtime() {
   Printf(runtime, "%s", s);
   Delete(s);
 
-  s = Swig_include_sys("swigerrors.swg");
-  if (!s) {
-    Printf(stderr, "*** Unable to open 'swigerrors.swg'\n");
-    Close(runtime);
-    SWIG_exit(EXIT_FAILURE);
-  }
-  Printf(runtime, "%s", s);
   s = Swig_include_sys("swigrun.swg");
   if (!s) {
     Printf(stderr, "*** Unable to open 'swigrun.swg'\n");
@@ -428,6 +439,8 @@ static void SWIG_dump_runtime() {
   Printf(runtime, "%s", s);
   Delete(s);
 
+  Printf(runtime, "\n#endif\n");
+
   Close(runtime);
   Delete(runtime);
   SWIG_exit(EXIT_SUCCESS);
@@ -503,11 +516,14 @@ void SWIG_getoptions(int argc, char *argv[]) {
 	Swig_mark_arg(i);
       } else if (strcmp(argv[i], "-runtime") == 0) { // Used to also accept -c. removed in swig-1.3.36
 	Swig_mark_arg(i);
-	Swig_warning(WARN_DEPRECATED_OPTC, "SWIG", 1, "-runtime, -noruntime command line options are deprecated.\n");
+	Swig_warning(WARN_DEPRECATED_OPTC, "SWIG", 1, "-runtime command line option is deprecated.\n");
 	SwigRuntime = 1;
       } else if (strcmp(argv[i], "-noruntime") == 0) {
 	Swig_mark_arg(i);
-	Swig_warning(WARN_DEPRECATED_OPTC, "SWIG", 1, "-runtime, -noruntime command line options are deprecated.\n");
+	if (lang->externalRuntimeInclude())
+	  Preprocessor_define((DOH *) "SWIG_NORUNTIME 1", 0);
+	else
+	  Swig_warning(WARN_DEPRECATED_OPTC, "SWIG", 1, "-noruntime command line option is deprecated for this language.\n");
 	SwigRuntime = 2;
       } else if (strcmp(argv[i], "-external-runtime") == 0) {
 	external_runtime = 1;
@@ -590,6 +606,15 @@ void SWIG_getoptions(int argc, char *argv[]) {
 	} else {
 	  Swig_arg_error();
 	}
+      } else if (strcmp(argv[i], "-manifest") == 0) {
+	Swig_mark_arg(i);
+	if (argv[i + 1]) {
+	  manifest_file = NewString(argv[i + 1]);
+	  Swig_mark_arg(i + 1);
+	  i++;
+	} else {
+	  Swig_arg_error();
+	}
       } else if (strcmp(argv[i], "-fakeversion") == 0) {
 	Swig_mark_arg(i);
 	if (argv[i + 1]) {
@@ -781,6 +806,10 @@ void SWIG_getoptions(int argc, char *argv[]) {
       } else if ((strcmp(argv[i], "-debug-classes") == 0) || (strcmp(argv[i], "-dump_classes") == 0)) {
 	dump_classes = 1;
 	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-debug-features") == 0) {
+	features_debug = 1;
+	Swig_features_debug_set(1);
+	Swig_mark_arg(i);
       } else if ((strcmp(argv[i], "-debug-memory") == 0) || (strcmp(argv[i], "-dump_memory") == 0)) {
 	memory_debug = 1;
 	Swig_mark_arg(i);
@@ -1116,6 +1145,13 @@ int SWIG_main(int argc, char *argv[], Language *l) {
     }
     Swig_default_allocators(top);
 
+    if (manifest_file) {
+      if (Verbose) {
+	Printf(stdout, "Applying usage manifest...\n");
+      }
+      Swig_usage_manifest(top, manifest_file);
+    }
+
     if (dump_top & STAGE3) {
       Printf(stdout, "debug-top stage 3\n");
       Swig_print_tree(top);
@@ -1207,6 +1243,8 @@ int SWIG_main(int argc, char *argv[], Language *l) {
   }
   if (tm_debug)
     Swig_typemap_debug();
+  if (features_debug)
+    Swig_features_debug();
   if (memory_debug)
     DohMemoryDebug();
 
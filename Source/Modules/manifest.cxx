@@ -0,0 +1,399 @@
+/* -----------------------------------------------------------------------------
+ * See the LICENSE file for information on copyright, usage and redistribution
+ * of SWIG, and the README file for authors - http://www.swig.org/release.html.
+ *
+ * manifest.cxx
+ *
+ * Support for usage manifests (the -manifest option).  A usage manifest lists
+ * the declarations that an application actually uses, one name per line.
+ * Every other class, function, variable, constant and enum is marked with
+ * feature:ignore so that no wrapper code is generated for it, unless it is a
+ * base class of a kept class or a class or enum used in the types of a kept
+ * declaration.  The pass runs after the type system has been built, so the
+ * inheritance graph is complete and the type table still contains the casts
+ * between a wrapped class and all of its derived classes, whether those are
+ * wrapped or not.
+ * ----------------------------------------------------------------------------- */
+
+char cvsroot_manifest_cxx[] = "$Id$";
+
+#include "swigmod.h"
+#include <ctype.h>
+
+static Hash *manifest = 0;	/* Names listed in the manifest */
+
+/* -----------------------------------------------------------------------------
+ * manifest_key()
+ *
+ * Returns the form of a name used for matching.  Whitespace and a leading
+ * global scope operator are removed, so that "std::pair<int, int>" and
+ * "::std::pair<int,int>" are the same name.
+ * ----------------------------------------------------------------------------- */
+
+static String *manifest_key(const_String_or_char_ptr name) {
+  String *key = NewStringEmpty();
+  const char *c = Char(name);
+  while (isspace((int) *c))
+    c++;
+  if (strncmp(c, "::", 2) == 0)
+    c += 2;
+  for (; *c; c++) {
+    if (!isspace((int) *c))
+      Putc(*c, key);
+  }
+  return key;
+}
+
+/* -----------------------------------------------------------------------------
+ * manifest_read()
+ *
+ * Reads the manifest.  Everything after a # on a line is a comment.
+ * ----------------------------------------------------------------------------- */
+
+static void manifest_read(String *filename) {
+  FILE *f = Swig_open(filename);
+  if (!f) {
+    FileErrorDisplay(filename);
+    SWIG_exit(EXIT_FAILURE);
+  }
+  String *contents = Swig_read_file(f);
+  fclose(f);
+
+  manifest = NewHash();
+  List *lines = Split(contents, '\n', -1);
+  for (Iterator li = First(lines); li.item; li = Next(li)) {
+    char *comment = Strchr(li.item, '#');
+    if (comment)
+      *comment = 0;
+    String *key = manifest_key(li.item);
+    if (Len(key))
+      Setattr(manifest, key, "1");
+    Delete(key);
+  }
+  Delete(lines);
+  Delete(contents);
+}
+
+/* -----------------------------------------------------------------------------
+ * listed()
+ *
+ * Checks whether the declaration n, a member of the class cls or a global
+ * declaration if cls is null, is named in the manifest.  A declaration can be
+ * listed by its fully qualified C++ name or by its target language name.  A
+ * class member can also be listed as <class>::<member>, using the target
+ * language name of the class.
+ * ----------------------------------------------------------------------------- */
+
+static bool listed(Node *n, Node *cls) {
+  String *name = Getattr(n, "name");
+  String *symname = Getattr(n, "sym:name");
+  bool found = false;
+
+  if (name && Len(name)) {
+    String *qualifier = Swig_symbol_qualified(n);
+    String *last = Swig_scopename_last(name);
+    String *qname = NewStringEmpty();
+    if (qualifier && Len(qualifier))
+      Printf(qname, "%s::", qualifier);
+    Append(qname, last);
+    String *str = SwigType_namestr(qname);
+    String *key = manifest_key(str);
+    found = Getattr(manifest, key) != 0;
+    Delete(key);
+    Delete(str);
+    Delete(qname);
+    Delete(last);
+    Delete(qualifier);
+  }
+
+  if (!found && symname) {
+    String *key;
+    if (cls) {
+      String *clsname = Getattr(cls, "sym:name");
+      String *member = NewStringf("%s::%s", clsname, symname);
+      key = manifest_key(member);
+      Delete(member);
+    } else {
+      key = manifest_key(symname);
+    }
+    found = Getattr(manifest, key) != 0;
+    Delete(key);
+  }
+  return found;
+}
+
+/* -----------------------------------------------------------------------------
+ * enum_listed()
+ *
+ * An enum is used if it or any of its items is listed.
+ * ----------------------------------------------------------------------------- */
+
+static bool enum_listed(Node *n, Node *cls) {
+  if (Getattr(n, "sym:name") && listed(n, cls))
+    return true;
+  for (Node *c = firstChild(n); c; c = nextSibling(c)) {
+    if (listed(c, cls))
+      return true;
+  }
+  return false;
+}
+
+/* -----------------------------------------------------------------------------
+ * is_member_decl()
+ *
+ * Returns true for the declarations that are kept or ignored by name.
+ * Constructors and destructors are always kept with their class, as are
+ * typedefs, which generate no wrappers.
+ * ----------------------------------------------------------------------------- */
+
+static bool is_member_decl(Node *n) {
+  String *ntype = nodeType(n);
+  if (Equal(ntype, "cdecl"))
+    return !Equal(Getattr(n, "storage"), "typedef");
+  return Equal(ntype, "constant") || Equal(ntype, "using");
+}
+
+/* -----------------------------------------------------------------------------
+ * is_scope()
+ *
+ * Returns true for the nodes whose children belong to the enclosing scope.
+ * The members added with %extend are children of an extend node.
+ * ----------------------------------------------------------------------------- */
+
+static bool is_scope(Node *n) {
+  String *ntype = nodeType(n);
+  return Equal(ntype, "namespace") || Equal(ntype, "include") || Equal(ntype, "extern") || Equal(ntype, "extend");
+}
+
+/* -----------------------------------------------------------------------------
+ * member_listed()
+ *
+ * Checks whether any member of the class cls, including the %extend members,
+ * is listed.
+ * ----------------------------------------------------------------------------- */
+
+static bool member_listed(Node *n, Node *cls) {
+  for (Node *m = firstChild(n); m; m = nextSibling(m)) {
+    if (Equal(nodeType(m), "extend")) {
+      if (member_listed(m, cls))
+	return true;
+    } else if ((is_member_decl(m) && listed(m, cls)) || (Equal(nodeType(m), "enum") && enum_listed(m, cls))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* -----------------------------------------------------------------------------
+ * decl_used()
+ *
+ * Checks whether the declaration n, a member of the class cls or a global
+ * declaration if cls is null, is used.  Returns false for the nodes that are
+ * neither kept nor ignored.
+ * ----------------------------------------------------------------------------- */
+
+static bool decl_used(Node *n, Node *cls) {
+  bool all = cls && GetFlag(cls, "manifest:all");
+  String *ntype = nodeType(n);
+  if (Equal(ntype, "enum"))
+    return all || GetFlag(n, "manifest:keep") || enum_listed(n, cls);
+  if (is_member_decl(n))
+    return all || listed(n, cls);
+  if (cls && (Equal(ntype, "constructor") || Equal(ntype, "destructor")))
+    return true;
+  return false;
+}
+
+/* -----------------------------------------------------------------------------
+ * keep_type()
+ *
+ * Keeps the classes and enums used by the type t, including those used in the
+ * parameters of a function pointer type and in template arguments.  Classes
+ * that were not kept before are added to queue.
+ * ----------------------------------------------------------------------------- */
+
+static void keep_type(SwigType *t, List *queue) {
+  if (!t)
+    return;
+  SwigType *resolved = SwigType_typedef_resolve_all(t);
+  List *elements = SwigType_split(resolved);
+  for (Iterator ei = First(elements); ei.item; ei = Next(ei)) {
+    List *parms = 0;
+    if (SwigType_isfunction(ei.item)) {
+      parms = SwigType_parmlist(ei.item);
+    } else if (SwigType_istemplate(ei.item)) {
+      String *args = SwigType_templateargs(ei.item);
+      parms = SwigType_parmlist(args);
+      Delete(args);
+    }
+    for (Iterator pi = First(parms); pi.item; pi = Next(pi)) {
+      keep_type(pi.item, queue);
+    }
+    Delete(parms);
+  }
+  Delete(elements);
+
+  String *base = SwigType_base(resolved);
+  Replaceall(base, "class ", "");
+  Replaceall(base, "struct ", "");
+  Replaceall(base, "union ", "");
+  Replaceall(base, "enum ", "");
+  if (strncmp(Char(base), "::", 2) == 0)
+    Delslice(base, 0, 2);
+  Node *n = Len(base) ? Swig_symbol_clookup(base, 0) : 0;
+  if (n && !GetFlag(n, "manifest:keep")) {
+    String *ntype = nodeType(n);
+    if (Equal(ntype, "class")) {
+      SetFlag(n, "manifest:keep");
+      Append(queue, n);
+    } else if (Equal(ntype, "enum")) {
+      SetFlag(n, "manifest:keep");
+    }
+  }
+  Delete(base);
+  Delete(resolved);
+}
+
+/* -----------------------------------------------------------------------------
+ * keep_decl_types()
+ *
+ * Keeps the classes and enums used by the types of the declaration n: its
+ * type, the parameter and return types of a function, and the types of the
+ * parameters of a constructor.
+ * ----------------------------------------------------------------------------- */
+
+static void keep_decl_types(Node *n, List *queue) {
+  keep_type(Getattr(n, "type"), queue);
+  keep_type(Getattr(n, "decl"), queue);
+  for (Parm *p = Getattr(n, "parms"); p; p = nextSibling(p)) {
+    keep_type(Getattr(p, "type"), queue);
+  }
+}
+
+/* -----------------------------------------------------------------------------
+ * keep_used_types()
+ *
+ * Keeps the classes and enums used by the types of every used declaration in
+ * the scope n, which is the class cls or the global scope if cls is null.
+ * Classes in the scope are not entered; they are handled once they are kept.
+ * ----------------------------------------------------------------------------- */
+
+static void keep_used_types(Node *n, Node *cls, List *queue) {
+  for (Node *c = firstChild(n); c; c = nextSibling(c)) {
+    if (GetFlag(c, "feature:ignore"))
+      continue;
+    if (is_scope(c))
+      keep_used_types(c, cls, queue);
+    else if (!Equal(nodeType(c), "enum") && decl_used(c, cls))
+      keep_decl_types(c, queue);
+  }
+}
+
+/* -----------------------------------------------------------------------------
+ * find_classes()
+ *
+ * First pass.  Flags each class that is listed ("manifest:all") or has a
+ * listed member ("manifest:keep").
+ * ----------------------------------------------------------------------------- */
+
+static void find_classes(Node *n, List *kept) {
+  for (Node *c = firstChild(n); c; c = nextSibling(c)) {
+    String *ntype = nodeType(c);
+    if (Equal(ntype, "class")) {
+      if (listed(c, 0)) {
+	SetFlag(c, "manifest:all");
+	SetFlag(c, "manifest:keep");
+      } else if (member_listed(c, c)) {
+	SetFlag(c, "manifest:keep");
+      }
+      if (GetFlag(c, "manifest:keep"))
+	Append(kept, c);
+      find_classes(c, kept);
+    } else if (is_scope(c)) {
+      find_classes(c, kept);
+    }
+  }
+}
+
+/* -----------------------------------------------------------------------------
+ * keep_reachable()
+ *
+ * Second pass.  Keeps, transitively, the base classes of every kept class and
+ * the classes and enums used in the types of every used declaration, so that
+ * a listed function returning a class gets the proxy class for it.
+ * ----------------------------------------------------------------------------- */
+
+static void keep_reachable(Node *top, List *queue) {
+  keep_used_types(top, 0, queue);
+  for (int i = 0; i < Len(queue); i++) {
+    Node *cls = Getitem(queue, i);
+    List *bases = Getattr(cls, "allbases");
+    for (Iterator bi = First(bases); bi.item; bi = Next(bi)) {
+      if (!GetFlag(bi.item, "manifest:keep")) {
+	SetFlag(bi.item, "manifest:keep");
+	Append(queue, bi.item);
+      }
+    }
+    keep_used_types(cls, cls, queue);
+  }
+}
+
+/* -----------------------------------------------------------------------------
+ * ignore_unused()
+ *
+ * Third pass.  Marks the declarations that are not used with feature:ignore.
+ * All the members of a listed class are kept; a class that is only kept for
+ * some of its members, as a base class or for its type keeps just those
+ * members and its constructors and destructors.  Imported modules are left
+ * alone.
+ * ----------------------------------------------------------------------------- */
+
+static void ignore_unused(Node *n, Node *cls, int *total, int *ignored) {
+  for (Node *c = firstChild(n); c; c = nextSibling(c)) {
+    String *ntype = nodeType(c);
+    bool used = true;
+    if (GetFlag(c, "feature:ignore"))
+      continue;
+    if (Equal(ntype, "class")) {
+      used = GetFlag(c, "manifest:keep") ? true : false;
+      if (used)
+	ignore_unused(c, c, total, ignored);
+    } else if (Equal(ntype, "enum") || is_member_decl(c)) {
+      used = decl_used(c, cls);
+    } else {
+      if (is_scope(c))
+	ignore_unused(c, cls, total, ignored);
+      continue;
+    }
+    (*total)++;
+    if (!used) {
+      SetFlag(c, "feature:ignore");
+      (*ignored)++;
+    }
+  }
+}
+
+/* -----------------------------------------------------------------------------
+ * Swig_usage_manifest()
+ *
+ * Ignores all the declarations not used according to the manifest in filename.
+ * ----------------------------------------------------------------------------- */
+
+void Swig_usage_manifest(Node *n, String *filename) {
+  int total = 0;
+  int ignored = 0;
+  List *kept = NewList();
+
+  manifest_read(filename);
+
+  find_classes(n, kept);
+  keep_reachable(n, kept);
+  Delete(kept);
+
+  ignore_unused(n, 0, &total, &ignored);
+  if (Verbose)
+    Printf(stdout, "Usage manifest: %d of %d declarations are not used\n", ignored, total);
+
+  Delete(manifest);
+  manifest = 0;
+}
@@ -1418,6 +1418,10 @@ public:
   String *defaultExternalRuntimeFilename() {
     return NewString("swigoctaverun.h");
   }
+
+  int externalRuntimeInclude() {
+    return 1;
+  }
 };
 
 extern "C" Language *swig_octave(void) {
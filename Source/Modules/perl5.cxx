@@ -1754,6 +1754,10 @@ public:
   String *defaultExternalRuntimeFilename() {
     return NewString("swigperlrun.h");
   }
+
+  int externalRuntimeInclude() {
+    return 1;
+  }
 };
 
 /* -----------------------------------------------------------------------------
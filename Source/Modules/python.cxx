@@ -3559,6 +3559,10 @@ public:
     return NewString("swigpyrun.h");
   }
 
+  virtual int externalRuntimeInclude() {
+    return 1;
+  }
+
 };
 
 /* ---------------------------------------------------------------
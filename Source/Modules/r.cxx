@@ -242,6 +242,7 @@ static void writeListByLine(List *l, File *out, bool quote = 0) {
 
 static const char *usage = (char *)"\
 R Options (available with -r)\n\
+     -cdispatch       - Select overloaded functions in C code rather than in R code\n\
      -copystruct      - Emit R code to copy C structs (on by default)\n\
      -cppcast         - Enable C++ casting operators (default) \n\
      -debug           - Output debug\n\
@@ -285,6 +286,56 @@ static int addCopyParameter(SwigType *type) {
   return(ok);
 }
 
+/*****
+      Get the R vector type used by %feature("vectorize") for a scalar
+      parameter or return type: INTSXP for the integer types, REALSXP
+      for the floating point types and LGLSXP for bool. Returns 0 for
+      any other type, which cannot be vectorized.
+*****/
+static const char *vectorType(SwigType *type) {
+  static const char *integers[] = {
+    "int", "signed int", "unsigned int", "short", "signed short", "unsigned short",
+    "long", "signed long", "unsigned long", "long long", "signed long long",
+    "unsigned long long", 0
+  };
+  SwigType *resolved = SwigType_typedef_resolve_all(type);
+  SwigType *base = SwigType_strip_qualifiers(resolved);
+  const char *sexptype = 0;
+  for (int i = 0; integers[i]; i++) {
+    if (!Strcmp(base, integers[i]))
+      sexptype = "INTSXP";
+  }
+  if (!Strcmp(base, "double") || !Strcmp(base, "float"))
+    sexptype = "REALSXP";
+  else if (!Strcmp(base, "bool"))
+    sexptype = "LGLSXP";
+  Delete(base);
+  Delete(resolved);
+  return sexptype;
+}
+
+/*****
+      The C accessor for the elements of an R vector of the given type.
+*****/
+static const char *vectorElements(const char *sexptype) {
+  if (!strcmp(sexptype, "INTSXP"))
+    return "INTEGER";
+  if (!strcmp(sexptype, "REALSXP"))
+    return "REAL";
+  return "LOGICAL";
+}
+
+/*****
+      The NA value of an R vector of the given type.
+*****/
+static const char *vectorNA(const char *sexptype) {
+  if (!strcmp(sexptype, "INTSXP"))
+    return "NA_INTEGER";
+  if (!strcmp(sexptype, "REALSXP"))
+    return "NA_REAL";
+  return "NA_LOGICAL";
+}
+
 static void replaceRClass(String *tm, SwigType *type) {
   String *tmp = getRClassName(type);
   String *tmp_base = getRClassName(type, 0);
@@ -315,6 +366,7 @@ public:
   int top(Node *n);
   
   void dispatchFunction(Node *n);
+  bool cDispatchFunction(Node *n);
   int functionWrapper(Node *n);
   int variableWrapper(Node *n);
 
@@ -416,6 +468,7 @@ protected:
 
 protected: 
   bool copyStruct;
+  bool cDispatch;
   bool memoryProfile;
   bool aggressiveGc;
 
@@ -436,6 +489,7 @@ protected:
   // State variables that carry information across calls to functionWrapper() 
   // from  member accessors and class declarations. 
   String *opaqueClassDeclaration;
+  String *classDestructorWrapper;
   int processing_variable;
   int processing_member_access_function;
   String *member_name;
@@ -450,6 +504,7 @@ protected:
   Hash *ClassMemberTable;
   Hash *ClassMethodsTable;
   Hash *SClassDefs;
+  Hash *SClassDestructors;
   Hash *SMethodInfo;
   
   // Information about routines that are generated and to be registered with 
@@ -483,6 +538,7 @@ protected:
 
 R::R() :
   copyStruct(false),
+  cDispatch(false),
   memoryProfile(false),
   aggressiveGc(false),
   sfile(0),
@@ -497,6 +553,7 @@ R::R() :
   s_init_routine(0),
   s_namespace(0),
   opaqueClassDeclaration(0),
+  classDestructorWrapper(0),
   processing_variable(0),
   processing_member_access_function(0),
   member_name(0),
@@ -507,6 +564,7 @@ R::R() :
   ClassMemberTable(0),
   ClassMethodsTable(0),
   SClassDefs(0),
+  SClassDestructors(0),
   SMethodInfo(0),
   registrationTable(0),
   functionPointerProxyTable(0),
@@ -765,6 +823,7 @@ void R::init() {
     NewStringf("%s", "vmaxset(r_vmax);\nif(r_nprotect)  Rf_unprotect(r_nprotect);\n\n");
   
   SClassDefs = NewHash();
+  SClassDestructors = NewHash();
   
   sfile = NewString("");
   f_init = NewString("");
@@ -1664,6 +1723,106 @@ void R::dispatchFunction(Node *n) {
   DelWrapper(f);
 }
 
+/*****************************************************
+ Generate the dispatch function for an overloaded function
+ with -cdispatch. The overload is chosen in C by the code
+ from Swig_overload_dispatch(), using the typecheck typemaps,
+ and its C wrapper is called directly, so the R coercion code
+ of the overloads is not run. The R function only converts
+ the result, which must be the same for all the overloads.
+ Returns false without generating anything if an overload
+ needs its R code: it has varargs, an enum parameter, which
+ is converted from its name in R, a function pointer or a
+ parameter without a typecheck typemap.
+******************************************************/
+bool R::cDispatchFunction(Node *n) {
+  String *symname = Getattr(n, "sym:name");
+  String *nodeType = Getattr(n, "nodeType");
+  bool constructor = (!Cmp(nodeType, "constructor")); 
+  String *scoerceout = 0;
+  int copy = 0;
+  bool ok = true;
+
+  for (Node *ni = Getattr(n, "sym:overloaded"); ok && ni; ni = Getattr(ni, "sym:nextSibling")) {
+    if (!Getattr(ni, "wrap:name"))
+      continue;
+    Parm *pi = Getattr(ni, "wrap:parms");
+    if (emit_isvarargs(pi))
+      ok = false;
+    for (Parm *p = pi; ok && p;) {
+      if (checkAttribute(p, "tmap:in:numinputs", "0")) {
+	p = Getattr(p, "tmap:in:next");
+	continue;
+      }
+      SwigType *resolved = SwigType_typedef_resolve_all(Getattr(p, "type"));
+      SwigType *base = SwigType_base(resolved);
+      if (!Getattr(p, "tmap:typecheck") || SwigType_isenum(base) || SwigType_isfunctionpointer(resolved))
+	ok = false;
+      Delete(base);
+      Delete(resolved);
+      p = Getattr(p, "tmap:in:next") ? Getattr(p, "tmap:in:next") : nextSibling(p);
+    }
+
+    String *tm = Getattr(ni, "r:scoerceout");
+    int addCopyParam = GetFlag(ni, "r:copy");
+    if (!scoerceout) {
+      scoerceout = tm;
+      copy = addCopyParam;
+    } else if (Cmp(tm, scoerceout) || addCopyParam != copy) {
+      ok = false;
+    }
+  }
+  if (!ok)
+    return false;
+
+  Wrapper *f = NewWrapper();
+  Wrapper *sfun = NewWrapper();
+  String *sfname = NewString(symname);
+
+  if (constructor)
+    Replace(sfname, "new_", "", DOH_REPLACE_FIRST);
+
+  String *wname = Swig_name_wrapper(symname);
+  Replace(wname, "_wrap", "R_swig", DOH_REPLACE_FIRST);
+  Append(wname, "__SWIG_dispatch");
+
+  /* $commaargs starts with a comma, which is removed below */
+  int maxargs;
+  String *dispatch = Swig_overload_dispatch(n, copy ? "return %s($commaargs, s_swig_copy);" : "return %s($commaargs);", &maxargs);
+  Replaceall(dispatch, "(, ", "(");
+
+  Printv(f->def, "SWIGEXPORT SEXP\n", wname, " ( SEXP args", copy ? ", SEXP s_swig_copy" : "", " )\n{\n", NIL);
+  Wrapper_add_local(f, "argc", "R_len_t argc = Rf_length(args)");
+  Wrapper_add_local(f, "ii", "R_len_t ii");
+  String *tmp = NewStringf("SEXP argv[%d]", maxargs);
+  Wrapper_add_local(f, "argv", tmp);
+  Delete(tmp);
+  Printf(f->code, "for (ii = 0; (ii < argc) && (ii < %d); ii++) {\n", maxargs);
+  Printf(f->code, "argv[ii] = VECTOR_ELT(args, ii);\n}\n");
+  Printv(f->code, dispatch, "\n", NIL);
+  Printf(f->code, "Rf_error(\"cannot find overloaded function for %s\");\n", sfname);
+  Printv(f->code, "return R_NilValue;\n}\n", NIL);
+
+  Printf(sfun->def, "`%s` <- function(...%s) {", sfname, copy ? ", .copy = FALSE" : "");
+  Printf(sfun->code, "%s.Call('%s', list(...), %sPACKAGE='%s')\n", Len(scoerceout) ? "ans = " : "", 
+	 wname, copy ? "as.logical(.copy), " : "", Rpackage);
+  if (Len(scoerceout))
+    Printf(sfun->code, "%s\n\nans\n", scoerceout);
+  Printv(sfun->code, "\n}", NIL);
+
+  Wrapper_print(f, f_wrapper);
+  Wrapper_print(sfun, sfile);
+  Printv(sfile, "# Dispatch function\n", NIL);
+  addRegistrationRoutine(wname, copy ? 2 : 1);
+
+  Delete(dispatch);
+  Delete(wname);
+  Delete(sfname);
+  DelWrapper(sfun);
+  DelWrapper(f);
+  return true;
+}
+
 /******************************************************************
 
 *******************************************************************/
@@ -1813,6 +1972,22 @@ int R::functionWrapper(Node *n) {
   num_required = emit_num_required(l);
   varargs = emit_isvarargs(l);
 
+  /* %feature("vectorize") makes a function whose parameters and return
+     value are all scalars of arithmetic type accept R vectors, which
+     are recycled to the length of the longest, and loop over them in C.
+     The elements are converted directly, so this is only done when the
+     in and out typemaps are the ones from the SWIG library. */
+  bool vectorize = GetFlag(n, "feature:vectorize") && nargs > 0 && !varargs
+    && !Getattr(n, "sym:overloaded") && !processing_variable && !processing_member_access_function
+    && (isVoidReturnType || (vectorType(type) && SWIG_library_file(Getfile(Swig_typemap_lookup("out", n, "result", 0)))));
+  for (p = l; vectorize && p; p = nextSibling(p)) {
+    if (!vectorType(Getattr(p, "type")) || !SWIG_library_file(Getfile(Getattr(p, "tmap:in")))
+	|| checkAttribute(p, "tmap:in:numinputs", "0") || Getattr(p, "tmap:argout"))
+      vectorize = false;
+  }
+  String *vectorLoop = NewString("");
+  String *vectorNAs = NewString("");
+
   Wrapper_add_local(f, "r_nprotect", "unsigned int r_nprotect = 0");
   Wrapper_add_localv(f, "r_ans", "SEXP", "r_ans = R_NilValue", NIL);
   Wrapper_add_localv(f, "r_vmax", "VMAXTYPE", "r_vmax = vmaxget()", NIL);
@@ -1904,7 +2079,7 @@ int R::functionWrapper(Node *n) {
 
     Printv(sfun->def, inFirstArg ? "" : ", ", name, NIL);
 
-    if ((tm = Getattr(p,"tmap:scheck"))) {
+    if (!vectorize && (tm = Getattr(p,"tmap:scheck"))) {
 
       Replaceall(tm,"$target", lname);
       Replaceall(tm,"$source", name);
@@ -1937,7 +2112,25 @@ int R::functionWrapper(Node *n) {
       }
 
 
-      Printf(f->code,"%s\n",tm);
+      if (vectorize) {
+	const char *sexptype = vectorType(Getattr(p, "type"));
+	String *len = NewStringf("r_len%d", i+1);
+	String *ltype = SwigType_lstr(Getattr(p, "type"), 0);
+	Wrapper_add_localv(f, len, "R_len_t", len, NIL);
+	Printf(f->code, "Rf_protect(%s = Rf_coerceVector(%s, %s));\nr_nprotect++;\n", name, name, sexptype);
+	Printf(f->code, "%s = Rf_length(%s);\n", len, name);
+	String *element = NewStringf("%s(%s)[r_i %% %s]", vectorElements(sexptype), name, len);
+	if (!strcmp(sexptype, "REALSXP"))
+	  Printf(vectorNAs, "%sISNA(%s)", Len(vectorNAs) ? " || " : "", element);
+	else
+	  Printf(vectorNAs, "%s%s == %s", Len(vectorNAs) ? " || " : "", element, vectorNA(sexptype));
+	Printf(vectorLoop, "%s = (%s) %s;\n", lname, ltype, element);
+	Delete(element);
+	Delete(ltype);
+	Delete(len);
+      } else {
+	Printf(f->code,"%s\n",tm);
+      }
       if(funcptr_name) 
 	Printf(f->code, "} else {\n%s = %s;\nR_SWIG_pushCallbackFunctionData(%s, NULL);\n}\n", 
 	       lname, funcptr_name, name);
@@ -2009,8 +2202,31 @@ int R::functionWrapper(Node *n) {
 
   String *actioncode = emit_action(n);
 
-  /* Deal with the explicit return value. */
-  if ((tm = Swig_typemap_lookup_out("out", n, "result", f, actioncode))) { 
+  if (vectorize) {
+    /* Recycle the arguments to the length of the longest, or to no
+       elements at all if any of them is empty, and call the function
+       for each element. The result is NA where any argument is NA,
+       without calling the function. */
+    Wrapper_add_local(f, "r_i", "R_len_t r_i");
+    Wrapper_add_local(f, "r_len", "R_len_t r_len = 0");
+    for (i = 0; i < nargs; i++)
+      Printf(f->code, "if (r_len%d > r_len) r_len = r_len%d;\n", i+1, i+1);
+    for (i = 0; i < nargs; i++)
+      Printf(f->code, "if (r_len%d == 0) r_len = 0;\n", i+1);
+    String *naResult = NewString("");
+    if (!isVoidReturnType) {
+      const char *sexptype = vectorType(type);
+      Printf(f->code, "Rf_protect(r_ans = Rf_allocVector(%s, r_len));\nr_nprotect++;\n", sexptype);
+      Printf(naResult, "%s(r_ans)[r_i] = %s;\n", vectorElements(sexptype), vectorNA(sexptype));
+      Printf(actioncode, "%s(r_ans)[r_i] = %s result;\n", vectorElements(sexptype), 
+	     strcmp(sexptype, "REALSXP") ? "(int)" : "(double)");
+    }
+    Printf(f->code, "for (r_i = 0; r_i < r_len; r_i++) {\nif (%s) {\n%scontinue;\n}\n%s%s}\n",
+	   vectorNAs, naResult, vectorLoop, actioncode);
+    Delete(naResult);
+    Delete(actioncode);
+  } else if ((tm = Swig_typemap_lookup_out("out", n, "result", f, actioncode))) { 
+    /* Deal with the explicit return value. */
     SwigType *retType = Getattr(n, "type");
     //Printf(stderr, "Return Value for %s, array? %s\n", retType, SwigType_isarray(retType) ? "yes" : "no");     
     /*      if(SwigType_isarray(retType)) {
@@ -2090,12 +2306,20 @@ int R::functionWrapper(Node *n) {
   }
 
 
+  /* Remembered for the C dispatch function of an overloaded function */
+  Setattr(n, "r:scoerceout", tm ? tm : "");
+  if (addCopyParam)
+    SetFlag(n, "r:copy");
+
   Printv(sfun->code, (Len(tm) ? "ans = " : ""), ".Call('", wname, 
 	 "', ", sargs, "PACKAGE='", Rpackage, "')\n", NIL);
   if(Len(tm))
     Printf(sfun->code, "%s\n\nans\n", tm);
-  if (destructor)
+  if (destructor) {
     Printv(f->code, "R_ClearExternalPtr(self);\n", NIL);
+    Delete(classDestructorWrapper);
+    classDestructorWrapper = Copy(wname);
+  }
 
   Printv(f->code, "return r_ans;\n}\n", NIL);
   Printv(sfun->code, "\n}", NIL);
@@ -2150,7 +2374,8 @@ int R::functionWrapper(Node *n) {
 
   if (Getattr(n, "sym:overloaded") &&
       !Getattr(n, "sym:nextSibling")) {
-    dispatchFunction(n);
+    if (!cDispatch || !cDispatchFunction(n))
+      dispatchFunction(n);
   }
 
   addRegistrationRoutine(wname, addCopyParam ? nargs +1 : nargs);
@@ -2158,6 +2383,8 @@ int R::functionWrapper(Node *n) {
   DelWrapper(f);
   DelWrapper(sfun);
 
+  Delete(vectorNAs);
+  Delete(vectorLoop);
   Delete(sargs);
   Delete(sfname);
   return SWIG_OK;
@@ -2296,6 +2523,34 @@ int R::classDeclaration(Node *n) {
 
   opaqueClassDeclaration = NULL;
 
+  /* Record the destructor wrapper in the client data of the type so
+     that the objects owned by R are deleted when they are collected.
+     A typedef can give a second class the same type, in which case
+     the first class keeps it. */
+  if (classDestructorWrapper) {
+    SwigType *t = Copy(name);
+    SwigType_add_pointer(t);
+    SwigType *fr = SwigType_typedef_resolve_all(t);
+    SwigType *qr = SwigType_typedef_qualified(fr);
+    SwigType *resolved = SwigType_strip_qualifiers(qr);
+    if (!Getattr(SClassDestructors, resolved)) {
+      String *mangled = Swig_name_mangle(Getattr(n, "sym:name"));
+      String *cdata = NewStringf("&_swig_r_class_%s", mangled);
+      Printf(f_wrapper, "static swig_r_clientdata _swig_r_class_%s = { %s };\n\n",
+	     mangled, classDestructorWrapper);
+      SwigType_remember_clientdata(t, cdata);
+      Setattr(SClassDestructors, resolved, cdata);
+      Delete(cdata);
+      Delete(mangled);
+    }
+    Delete(resolved);
+    Delete(qr);
+    Delete(fr);
+    Delete(t);
+    Delete(classDestructorWrapper);
+    classDestructorWrapper = NULL;
+  }
+
 
   // OutputArrayMethod(name, class_member_functions, sfile);        
   if (class_member_functions)
@@ -2433,7 +2688,6 @@ int R::generateCopyRoutines(Node *n) {
     }
     String *elKind = Getattr(c, "kind");
     if (Strcmp(elKind, "variable") != 0) {
-      Delete(elKind);
       continue;
     }
 
@@ -2573,6 +2827,7 @@ void R::main(int argc, char *argv[]) {
   SWIG_config_file("r.swg");
   debugMode = false;
   copyStruct = true;
+  cDispatch = false;
   memoryProfile = false;
   aggressiveGc = false;
   inCPlusMode = false;
@@ -2616,6 +2871,9 @@ void R::main(int argc, char *argv[]) {
     } else if (!strcmp(argv[i],"-nocppcast")) {
       cppcast = false;
       Swig_mark_arg(i);
+    } else if (!strcmp(argv[i], "-cdispatch")) {
+      cDispatch = true;
+      Swig_mark_arg(i);
     } else if (!strcmp(argv[i],"-copystruct")) {
       copyStruct = true;
       Swig_mark_arg(i);
@@ -2361,13 +2361,13 @@ public:
 	  SwigType_remember(btype);
 	  if (multipleInheritance) {
 	    String *bmangle = SwigType_manglestr(btype);
-	    Insert(bmangle, 0, "((swig_class *) SWIGTYPE");
+	    Insert(bmangle, 0, "SWIG_Ruby_UseClass((swig_class *) SWIGTYPE");
 	    Append(bmangle, "->clientdata)->mImpl");
 	    Printv(klass->init, "rb_include_module(", klass->mImpl, ", ", bmangle, ");\n", NIL);
 	    Delete(bmangle);
 	  } else {
 	    String *bmangle = SwigType_manglestr(btype);
-	    Insert(bmangle, 0, "((swig_class *) SWIGTYPE");
+	    Insert(bmangle, 0, "SWIG_Ruby_UseClass((swig_class *) SWIGTYPE");
 	    Append(bmangle, "->clientdata)->klass");
 	    Replaceall(klass->init, "$super", bmangle);
 	    Delete(bmangle);
@@ -2414,7 +2414,15 @@ public:
   void handleFreeFuncDirective(Node *n) {
     String *freefunc = Getattr(n, "feature:freefunc");
     if (freefunc) {
-      Printf(klass->init, "SwigClass%s.destroy = (void (*)(void *)) %s;\n", klass->name, freefunc);
+      if (GetFlag(n, "feature:trackobjects")) {
+	/* Remove the tracking of a freed object even if the user's free function does not */
+	Printf(f_wrappers, "SWIGINTERN void\nfree_tracked_%s(void *ptr) {\n", klass->mname);
+	Printf(f_wrappers, "%sSWIG_RubyRemoveTracking(ptr);\n", tab4);
+	Printf(f_wrappers, "%s((void (*)(void *)) %s)(ptr);\n}\n\n", tab4, freefunc);
+	Printf(klass->init, "SwigClass%s.destroy = free_tracked_%s;\n", klass->name, klass->mname);
+      } else {
+	Printf(klass->init, "SwigClass%s.destroy = (void (*)(void *)) %s;\n", klass->name, freefunc);
+      }
     } else {
       if (klass->destructor_defined) {
 	Printf(klass->init, "SwigClass%s.destroy = (void (*)(void *)) free_%s;\n", klass->name, klass->mname);
@@ -2474,9 +2482,7 @@ public:
     SwigType_remember(tt);
     String *tm = SwigType_manglestr(tt);
     Printf(klass->init, "SWIG_TypeClientData(SWIGTYPE%s, (void *) &SwigClass%s);\n", tm, valid_name);
-    Delete(tm);
     Delete(tt);
-    Delete(valid_name);
 
     includeRubyModules(n);
 
@@ -2506,7 +2512,16 @@ public:
     }
     Delete(s);
 
-    Printv(f_init, klass->init, NIL);
+    /* The class is set up by its own function, which SWIG_Ruby_InitClass()
+       may defer until the class is first used */
+    Wrapper *f = NewWrapper();
+    Printv(f->def, "SWIGINTERN void\ndefine_", klass->mname, "(void) {", NIL);
+    Printv(f->code, klass->init, "}\n", NIL);
+    Wrapper_print(f, f_wrappers);
+    DelWrapper(f);
+    Printv(f_init, tab4, "SWIG_Ruby_InitClass(", useGlobalModule ? "rb_cObject" : Char(modvar), ", \"", klass->name, "\", SWIGTYPE", tm, ", &SwigClass", valid_name, ", define_", klass->mname, ");\n", NIL);
+    Delete(tm);
+    Delete(valid_name);
     klass = 0;
     return SWIG_OK;
   }
@@ -3406,6 +3421,10 @@ public:
   String *defaultExternalRuntimeFilename() {
     return NewString("swigrubyrun.h");
   }
+
+  int externalRuntimeInclude() {
+    return 1;
+  }
 };				/* class RUBY */
 
 /* -----------------------------------------------------------------------------
@@ -216,6 +216,7 @@ public:
   virtual int is_assignable(Node *n);	/* Is variable assignable? */
   virtual String *runtimeCode();	/* returns the language specific runtime code */
   virtual String *defaultExternalRuntimeFilename();	/* the default filename for the external runtime */
+  virtual int externalRuntimeInclude();	/* does -noruntime #include the external runtime? */
   virtual void replaceSpecialVariables(String *method, String *tm, Parm *parm); /* Language specific special variable substitutions for $typemap() */
 
   /* Runtime is C++ based, so extern "C" header section */
@@ -326,6 +327,7 @@ void SWIG_config_cppext(const char *ext);
 List *SWIG_output_files();
 
 void SWIG_library_directory(const char *);
+int SWIG_library_file(const_String_or_char_ptr filename);
 int emit_num_arguments(ParmList *);
 int emit_num_required(ParmList *);
 int emit_isvarargs(ParmList *);
@@ -386,6 +388,7 @@ int Swig_contract_mode_get();
 void Swig_browser(Node *n, int);
 void Swig_default_allocators(Node *n);
 void Swig_process_types(Node *n);
+void Swig_usage_manifest(Node *n, String *filename);
 
 
 #endif
@@ -26,6 +26,8 @@ static String *var_tab = 0;	/* Table of global variables */
 static String *const_tab = 0;	/* Constant table            */
 static String *methods_tab = 0;	/* Methods table             */
 static String *attr_tab = 0;	/* Attribute table           */
+static String *class_cmd_tab = 0;	/* Commands of the current class */
+static String *class_tab = 0;	/* Table of classes          */
 static String *prefix = 0;
 static String *module = 0;
 static int nspace = 0;
@@ -161,6 +163,7 @@ public:
     var_tab = NewString("");
     methods_tab = NewString("");
     const_tab = NewString("");
+    class_tab = NewString("");
 
     Swig_banner(f_begin);
 
@@ -215,6 +218,7 @@ public:
     Printf(cmd_tab, "\nstatic swig_command_info swig_commands[] = {\n");
     Printf(var_tab, "\nstatic swig_var_info swig_variables[] = {\n");
     Printf(const_tab, "\nstatic swig_const_info swig_constants[] = {\n");
+    Printf(class_tab, "\nstatic swig_class *swig_classes[] = {\n");
 
     Printf(f_wrappers, "#ifdef __cplusplus\nextern \"C\" {\n#endif\n");
 
@@ -225,8 +229,9 @@ public:
     Printv(cmd_tab, tab4, "{0, 0, 0}\n", "};\n", NIL);
     Printv(var_tab, tab4, "{0,0,0,0}\n", "};\n", NIL);
     Printv(const_tab, tab4, "{0,0,0,0,0,0}\n", "};\n", NIL);
+    Printv(class_tab, tab4, "0\n", "};\n", NIL);
 
-    Printv(f_wrappers, cmd_tab, var_tab, const_tab, NIL);
+    Printv(f_wrappers, cmd_tab, var_tab, const_tab, class_tab, NIL);
 
     /* Dump the pointer equivalency table */
     SwigType_emit_type_table(f_runtime, f_wrappers);
@@ -510,7 +515,7 @@ public:
 
     if (!Getattr(n, "sym:overloaded")) {
       /* Register the function with Tcl */
-      Printv(cmd_tab, tab4, "{ SWIG_prefix \"", iname, "\", (swig_wrapper_func) ", Swig_name_wrapper(iname), ", NULL},\n", NIL);
+      Printv(class_cmd_tab ? class_cmd_tab : cmd_tab, tab4, "{ SWIG_prefix \"", iname, "\", (swig_wrapper_func) ", Swig_name_wrapper(iname), ", NULL},\n", NIL);
     } else {
       if (!Getattr(n, "sym:nextSibling")) {
 	/* Emit overloading dispatch function */
@@ -531,7 +536,7 @@ public:
 	Printf(df->code, "return TCL_ERROR;\n");
 	Printv(df->code, "}\n", NIL);
 	Wrapper_print(df, f_wrappers);
-	Printv(cmd_tab, tab4, "{ SWIG_prefix \"", iname, "\", (swig_wrapper_func) ", dname, ", NULL},\n", NIL);
+	Printv(class_cmd_tab ? class_cmd_tab : cmd_tab, tab4, "{ SWIG_prefix \"", iname, "\", (swig_wrapper_func) ", dname, ", NULL},\n", NIL);
 	DelWrapper(df);
 	Delete(dispatch);
 	Delete(dname);
@@ -768,8 +773,12 @@ public:
     Printf(methods_tab, "static swig_method swig_");
     Printv(methods_tab, mangled_classname, "_methods[] = {\n", NIL);
 
-    /* Generate normal wrappers */
+    /* Generate normal wrappers.  Their commands are kept in a table of
+       the class, so that they can be created when the class is first used */
+    String *commands_tab = NewString("");
+    class_cmd_tab = commands_tab;
     Language::classHandler(n);
+    class_cmd_tab = 0;
 
     SwigType *t = Copy(Getattr(n, "name"));
     SwigType_add_pointer(t);
@@ -939,6 +948,8 @@ public:
       Printv(f_shadow, "}\n\n", NIL);
     }
 
+    Printv(f_wrappers, "static swig_command_info swig_", mangled_classname, "_commands[] = {\n", commands_tab, tab4, "{0, 0, 0}\n", "};\n", NIL);
+    Delete(commands_tab);
     Printv(f_wrappers, "static swig_class *swig_", mangled_classname, "_bases[] = {", base_class, "0};\n", NIL);
     Printv(f_wrappers, "static const char * swig_", mangled_classname, "_base_names[] = {", base_class_names, "0};\n", NIL);
     Delete(base_class);
@@ -959,7 +970,8 @@ public:
       Printf(f_wrappers, ",0");
     }
     Printv(f_wrappers, ", swig_", mangled_classname, "_methods, swig_", mangled_classname, "_attributes, swig_", mangled_classname, "_bases,",
-	   "swig_", mangled_classname, "_base_names, &swig_module };\n", NIL);
+	   "swig_", mangled_classname, "_base_names, &swig_module, swig_", mangled_classname, "_commands };\n", NIL);
+    Printv(class_tab, tab4, "&_wrap_class_", mangled_classname, ",\n", NIL);
 
     if (!itcl) {
       Printv(cmd_tab, tab4, "{ SWIG_prefix \"", class_name, "\", (swig_wrapper_func) SWIG_ObjectConstructor, (ClientData)&_wrap_class_", mangled_classname,
@@ -1292,6 +1304,10 @@ public:
   String *defaultExternalRuntimeFilename() {
     return NewString("swigtclrun.h");
   }
+
+  int externalRuntimeInclude() {
+    return 1;
+  }
 };
 
 /* ----------------------------------------------------------------------
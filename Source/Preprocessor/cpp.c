@@ -113,6 +113,7 @@ List *Preprocessor_depend(void) {
  * void Preprocessor_cpp_init() - Initialize the preprocessor
  * ----------------------------------------------------------------------------- */
 static String *kpp_args = 0;
+static String *kpp_body = 0;
 static String *kpp_define = 0;
 static String *kpp_defined = 0;
 static String *kpp_elif = 0;
@@ -148,6 +149,7 @@ void Preprocessor_init(void) {
   Hash *s;
 
   kpp_args = NewString("args");
+  kpp_body = NewString("*body*");
   kpp_define = NewString("define");
   kpp_defined = NewString("defined");
   kpp_else = NewString("else");
@@ -193,6 +195,7 @@ void Preprocessor_init(void) {
 
 void Preprocessor_delete(void) {
   Delete(kpp_args);
+  Delete(kpp_body);
   Delete(kpp_define);
   Delete(kpp_defined);
   Delete(kpp_else);
@@ -254,6 +257,162 @@ void Preprocessor_error_as_warning(int a) {
 }
 
 
+/* -----------------------------------------------------------------------------
+ * Macro bodies
+ *
+ * The value of a macro is split up once, when the macro is defined, into
+ * pieces of literal text and references to the macro arguments.  expand_macro()
+ * then builds an expansion with a single pass over these pieces rather than
+ * searching and replacing every argument name in a copy of the macro value.
+ * ----------------------------------------------------------------------------- */
+
+#define MACRO_TEXT           0	/* Literal text */
+#define MACRO_ARG            1	/* x    : Macro expanded argument */
+#define MACRO_ARG_RAW        2	/* x##y : Unexpanded argument */
+#define MACRO_ARG_STR        3	/* #x   : Quoted argument */
+#define MACRO_ARG_QUOTE      4	/* `x`  : Quoted argument, unless already quoted */
+#define MACRO_ARG_MANGLE     5	/* #@x  : Mangled argument */
+#define MACRO_ARG_MANGLE_STR 6	/* ##@x : Quoted mangled argument */
+
+typedef struct {
+  int type;
+  int arg;			/* Index of the macro argument */
+  int paste;			/* Variable length argument following ## */
+  String *text;			/* Literal text for MACRO_TEXT */
+} MacroPiece;
+
+typedef struct {
+  int npieces;
+  MacroPiece *pieces;
+} MacroBody;
+
+/* Test a character to see if it is part of an identifier as matched by DOH_REPLACE_ID */
+#define ismacroidchar(c) ((isalnum(c)) || (c == '_'))
+
+static void macro_body_delete(void *ptr) {
+  MacroBody *body = (MacroBody *) ptr;
+  int i;
+  for (i = 0; i < body->npieces; i++) {
+    Delete(body->pieces[i].text);
+  }
+  free(body->pieces);
+  free(body);
+}
+
+static MacroPiece *macro_body_add(MacroBody *body, int type, int arg) {
+  MacroPiece *p;
+  if (!(body->npieces & (body->npieces - 1))) {
+    /* Double the size of the array whenever npieces reaches a power of two */
+    body->pieces = (MacroPiece *) realloc(body->pieces, (body->npieces ? 2 * body->npieces : 1) * sizeof(MacroPiece));
+    assert(body->pieces);
+  }
+  p = &body->pieces[body->npieces++];
+  p->type = type;
+  p->arg = arg;
+  p->paste = 0;
+  p->text = 0;
+  return p;
+}
+
+/* Returns the index of the macro argument named by the identifier at s, or -1 */
+static int macro_arg_index(List *arglist, const char *s, int *len) {
+  int i, nargs;
+  const char *c = s;
+  while (ismacroidchar((unsigned char) *c))
+    c++;
+  *len = (int) (c - s);
+  if (!*len || !arglist)
+    return -1;
+  nargs = Len(arglist);
+  for (i = 0; i < nargs; i++) {
+    String *aname = Getitem(arglist, i);
+    if ((Len(aname) == *len) && (strncmp(Char(aname), s, *len) == 0))
+      return i;
+  }
+  return -1;
+}
+
+/* -----------------------------------------------------------------------------
+ * macro_compile()
+ *
+ * Splits a macro value, in which # and ## have already been replaced with the
+ * special tokens \001 to \005, into a MacroBody.  Arguments are matched as
+ * whole identifiers, the same as for DOH_REPLACE_ID.
+ * ----------------------------------------------------------------------------- */
+
+static MacroBody *macro_compile(String *value, List *arglist, int varargs) {
+  MacroBody *body;
+  String *text;
+  char *s = Char(value);
+  int i = 0;
+
+  body = (MacroBody *) malloc(sizeof(MacroBody));
+  assert(body);
+  body->npieces = 0;
+  body->pieces = 0;
+  text = NewStringEmpty();
+
+  while (s[i]) {
+    int c = (unsigned char) s[i];
+    int type = MACRO_TEXT;
+    int arg = -1;
+    int len = 0;
+    int skip = 0;
+    if (ismacroidchar(c)) {
+      arg = macro_arg_index(arglist, s + i, &len);
+      if (arg >= 0)
+	type = (((i > 0) && (s[i - 1] == '\002')) || (s[i + len] == '\002')) ? MACRO_ARG_RAW : MACRO_ARG;
+    } else if ((c == '\001') || (c == '\004') || (c == '\005')) {
+      arg = macro_arg_index(arglist, s + i + 1, &len);
+      if (arg >= 0) {
+	type = (c == '\001') ? MACRO_ARG_STR : (c == '\004') ? MACRO_ARG_MANGLE : MACRO_ARG_MANGLE_STR;
+	skip = 1;
+      } else {
+	len = 0;
+      }
+    } else if (c == '`') {
+      arg = macro_arg_index(arglist, s + i + 1, &len);
+      if ((arg >= 0) && (s[i + 1 + len] == '`')) {
+	type = MACRO_ARG_QUOTE;
+	skip = 2;
+      } else {
+	len = 0;
+      }
+    }
+
+    if (type != MACRO_TEXT) {
+      MacroPiece *p;
+      if (Len(text)) {
+	p = macro_body_add(body, MACRO_TEXT, -1);
+	p->text = text;
+	text = NewStringEmpty();
+      }
+      p = macro_body_add(body, type, arg);
+      p->paste = varargs && (type == MACRO_ARG_RAW) && (arg == Len(arglist) - 1) && (i > 0) && (s[i - 1] == '\002');
+      i += len + skip;
+    } else if (len) {
+      /* An identifier that is not an argument */
+      while (len--)
+	Putc(s[i++], text);
+    } else {
+      if (c == '\001')
+	Putc('#', text);	/* Put # back (non-standard C) */
+      else if (c == '\004')
+	Append(text, "#@");	/* Put # back (non-standard C) */
+      else if (c != '\002')	/* Get rid of concatenation tokens */
+	Putc(c, text);
+      i++;
+    }
+  }
+  if (Len(text)) {
+    MacroPiece *p = macro_body_add(body, MACRO_TEXT, -1);
+    p->text = text;
+  } else {
+    Delete(text);
+  }
+  return body;
+}
+
 /* -----------------------------------------------------------------------------
  * Preprocessor_define()
  *
@@ -294,6 +453,7 @@ Hash *Preprocessor_define(const_String_or_char_ptr _str, int swigmacro) {
   String *macroname = 0, *argstr = 0, *macrovalue = 0, *file = 0, *s = 0;
   Hash *macro = 0, *symbols = 0, *m1;
   List *arglist = 0;
+  DOH *body;
   int c, line;
   int varargs = 0;
   String *str;
@@ -496,6 +656,9 @@ Hash *Preprocessor_define(const_String_or_char_ptr _str, int swigmacro) {
     }
   }
   Setattr(macro, kpp_value, macrovalue);
+  body = NewVoid(macro_compile(macrovalue, Getattr(macro, kpp_args), varargs), macro_body_delete);
+  Setattr(macro, kpp_body, body);
+  Delete(body);
   Setline(macro, line);
   Setfile(macro, file);
   if (swigmacro) {
@@ -693,8 +856,10 @@ static String *get_options(String *str) {
 
 static String *expand_macro(String *name, List *args) {
   String *ns;
-  DOH *symbols, *macro, *margs, *mvalue, *temp, *tempa, *e;
-  int i, l;
+  String **reparg = 0;
+  DOH *symbols, *macro, *margs, *mvalue, *e;
+  MacroBody *body;
+  int i, nargs;
   int isvarargs = 0;
 
   symbols = Getattr(cpp, kpp_symbols);
@@ -767,121 +932,78 @@ static String *expand_macro(String *name, List *args) {
     return NewString(name);
   }
 
-  /* Copy the macro value */
-  ns = Copy(mvalue);
+  /* Build the expansion from the pieces of the macro body */
+  body = (MacroBody *) GetVoid(macro, kpp_body);
+  ns = NewStringEmpty();
   copy_location(mvalue, ns);
+  nargs = (args && margs) ? Len(margs) : 0;
+  if (nargs) {
+    reparg = (String **) calloc(nargs, sizeof(String *));
+    assert(reparg);
+  }
 
-  /* Tag the macro as being expanded.   This is to avoid recursion in
-     macro expansion */
-
-  temp = NewStringEmpty();
-  tempa = NewStringEmpty();
-  if (args && margs) {
-    l = Len(margs);
-    for (i = 0; i < l; i++) {
-      DOH *arg, *aname;
-      String *reparg;
-      arg = Getitem(args, i);	/* Get an argument value */
-      reparg = Preprocessor_replace(arg);
-      aname = Getitem(margs, i);	/* Get macro argument name */
-      if (strstr(Char(ns), "\001")) {
-	/* Try to replace a quoted version of the argument */
-	Clear(temp);
-	Clear(tempa);
-	Printf(temp, "\001%s", aname);
-	Printf(tempa, "\"%s\"", arg);
-	Replace(ns, temp, tempa, DOH_REPLACE_ID_END);
-      }
-      if (strstr(Char(ns), "\002")) {
-	/* Look for concatenation tokens */
-	Clear(temp);
-	Clear(tempa);
-	Printf(temp, "\002%s", aname);
-	Append(tempa, "\002\003");
-	Replace(ns, temp, tempa, DOH_REPLACE_ID_END);
-	Clear(temp);
-	Clear(tempa);
-	Printf(temp, "%s\002", aname);
-	Append(tempa, "\003\002");
-	Replace(ns, temp, tempa, DOH_REPLACE_ID_BEGIN);
+  for (i = 0; i < body->npieces; i++) {
+    MacroPiece *p = &body->pieces[i];
+    String *arg, *marg;
+    if (p->type == MACRO_TEXT) {
+      Append(ns, p->text);
+      continue;
+    }
+    arg = Getitem(args, p->arg);
+    switch (p->type) {
+    case MACRO_ARG:
+      /* Replace expanded args */
+      if (!reparg[p->arg])
+	reparg[p->arg] = Preprocessor_replace(arg);
+      Append(ns, reparg[p->arg]);
+      break;
+    case MACRO_ARG_RAW:
+      if (p->paste && (Len(arg) == 0)) {
+	/* Zero length varargs macro argument.   We search for commas that might appear before and nuke them */
+	char *s = Char(ns);
+	char *t = s + Len(ns) - 1;
+	while (t >= s) {
+	  if (isspace((int) *t))
+	    t--;
+	  else if (*t == ',') {
+	    *t = ' ';
+	  } else
+	    break;
+	}
       }
-
+      /* Replace unexpanded arg */
+      Append(ns, arg);
+      break;
+    case MACRO_ARG_STR:
+      Printf(ns, "\"%s\"", arg);
+      break;
+    case MACRO_ARG_QUOTE:
       /* Non-standard macro expansion.   The value `x` is replaced by a quoted
          version of the argument except that if the argument is already quoted
          nothing happens */
-
-      if (strchr(Char(ns), '`')) {
-	String *rep;
-	char *c;
-	Clear(temp);
-	Printf(temp, "`%s`", aname);
-	c = Char(arg);
-	if (*c == '\"') {
-	  rep = arg;
-	} else {
-	  Clear(tempa);
-	  Printf(tempa, "\"%s\"", arg);
-	  rep = tempa;
-	}
-	Replace(ns, temp, rep, DOH_REPLACE_ANY);
-      }
-
+      if (*Char(arg) == '\"')
+	Append(ns, arg);
+      else
+	Printf(ns, "\"%s\"", arg);
+      break;
+    case MACRO_ARG_MANGLE:
       /* Non-standard mangle expansions.  
          The #@Name is replaced by mangle_arg(Name). */
-      if (strstr(Char(ns), "\004")) {
-	String *marg = Swig_string_mangle(arg);
-	Clear(temp);
-	Printf(temp, "\004%s", aname);
-	Replace(ns, temp, marg, DOH_REPLACE_ID_END);
-	Delete(marg);
-      }
-      if (strstr(Char(ns), "\005")) {
-	String *marg = Swig_string_mangle(arg);
-	Clear(temp);
-	Clear(tempa);
-	Printf(temp, "\005%s", aname);
-	Printf(tempa, "\"%s\"", marg);
-	Replace(ns, temp, tempa, DOH_REPLACE_ID_END);
-	Delete(marg);
-      }
-
-      if (isvarargs && i == l - 1 && Len(arg) == 0) {
-	/* Zero length varargs macro argument.   We search for commas that might appear before and nuke them */
-	char *a, *s, *t, *name;
-	int namelen;
-	s = Char(ns);
-	name = Char(aname);
-	namelen = Len(aname);
-	a = strstr(s, name);
-	while (a) {
-	  char ca = a[namelen + 1];
-	  if (!isidchar((int) ca)) {
-	    /* Matched the entire vararg name, not just a prefix */
-	    t = a - 1;
-	    if (*t == '\002') {
-	      t--;
-	      while (t >= s) {
-		if (isspace((int) *t))
-		  t--;
-		else if (*t == ',') {
-		  *t = ' ';
-		} else
-		  break;
-	      }
-	    }
-	  }
-	  a = strstr(a + namelen, name);
-	}
-      }
-      /*      Replace(ns, aname, arg, DOH_REPLACE_ID); */
-      Replace(ns, aname, reparg, DOH_REPLACE_ID);	/* Replace expanded args */
-      Replace(ns, "\003", arg, DOH_REPLACE_ANY);	/* Replace unexpanded arg */
-      Delete(reparg);
+      marg = Swig_string_mangle(arg);
+      Append(ns, marg);
+      Delete(marg);
+      break;
+    case MACRO_ARG_MANGLE_STR:
+      marg = Swig_string_mangle(arg);
+      Printf(ns, "\"%s\"", marg);
+      Delete(marg);
+      break;
     }
   }
-  Replace(ns, "\002", "", DOH_REPLACE_ANY);	/* Get rid of concatenation tokens */
-  Replace(ns, "\001", "#", DOH_REPLACE_ANY);	/* Put # back (non-standard C) */
-  Replace(ns, "\004", "#@", DOH_REPLACE_ANY);	/* Put # back (non-standard C) */
+  for (i = 0; i < nargs; i++) {
+    Delete(reparg[i]);
+  }
+  free(reparg);
 
   /* Expand this macro even further */
   Setattr(macro, kpp_expanded, "1");
@@ -917,8 +1039,6 @@ static String *expand_macro(String *name, List *args) {
     Delete(e);
     e = f;
   }
-  Delete(temp);
-  Delete(tempa);
   return e;
 }
 
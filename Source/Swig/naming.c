@@ -12,6 +12,7 @@ char cvsroot_naming_c[] = "$Id$";
 #include "swig.h"
 #include "cparse.h"
 #include <ctype.h>
+#include <time.h>
 
 /* Hash table containing naming data */
 
@@ -599,6 +600,11 @@ static void merge_features(Hash *features, Node *n) {
  * the declaration, decl.
  * ----------------------------------------------------------------------------- */
 
+/* Counted for -debug-features */
+static int features_lookups = 0;
+static int features_debug = 0;
+static clock_t features_time = 0;
+
 static
 void features_get(Hash *features, const String *tname, SwigType *decl, SwigType *ncdecl, Node *node) {
   Node *n = Getattr(features, tname);
@@ -617,6 +623,7 @@ void Swig_features_get(Hash *features, String *prefix, String *name, SwigType *d
   char *ncdecl = 0;
   String *rdecl = 0;
   String *rname = 0;
+  clock_t start = 0;
   if (!features)
     return;
 
@@ -658,6 +665,11 @@ void Swig_features_get(Hash *features, String *prefix, String *name, SwigType *d
   Printf(stdout, "Swig_features_get: '%s' '%s' '%s'\n", prefix, name, decl);
 #endif
 
+  /* Only timed with -debug-features, as clock() is not free */
+  if (features_debug)
+    start = clock();
+  features_lookups++;
+
   /* Global features */
   features_get(features, "", 0, 0, node);
   if (name) {
@@ -703,6 +715,9 @@ void Swig_features_get(Hash *features, String *prefix, String *name, SwigType *d
     }
     Delete(tname);
   }
+  if (features_debug)
+    features_time += clock() - start;
+
   if (name && SwigType_istemplate(name)) {
     /* add features for complete template type */
     String *dname = Swig_symbol_template_deftype(name, 0);
@@ -718,6 +733,29 @@ void Swig_features_get(Hash *features, String *prefix, String *name, SwigType *d
     Delete(rdecl);
 }
 
+/* -----------------------------------------------------------------------------
+ * Swig_features_debug_set()
+ *
+ * Turns on the timing of the feature lookups for Swig_features_debug().
+ * ----------------------------------------------------------------------------- */
+
+void Swig_features_debug_set(int on) {
+  features_debug = on;
+}
+
+/* -----------------------------------------------------------------------------
+ * Swig_features_debug()
+ *
+ * Displays statistics about the feature lookups.
+ * ----------------------------------------------------------------------------- */
+
+void Swig_features_debug(void) {
+  Printf(stdout, "---[ features ]--------------------------------------------------------------\n");
+  Printf(stdout, "lookups: %d\n", features_lookups);
+  Printf(stdout, "time: %.3fs\n", (double) features_time / CLOCKS_PER_SEC);
+  Printf(stdout, "-----------------------------------------------------------------------------\n");
+}
+
 
 /* -----------------------------------------------------------------------------
  * Swig_feature_set()
@@ -810,17 +848,34 @@ Hash *Swig_name_rename_hash() {
   return rename_hash;
 }
 
-static List *namewarn_list = 0;
-List *Swig_name_namewarn_list() {
+/* The 'list' nameobjs (rename/namewarn objects using a match list, a
+   format or a regular expression) are kept in two parts. Those with a
+   plain target name are indexed by that name in "named", each name
+   keeping its own list, while the rest are kept in "others". Every
+   nameobj gets a "serial" number, the last inserted one taking precedence. */
+
+static Hash *Swig_name_nameobj_list() {
+  Hash *nlist = NewHash();
+  Hash *named = NewHash();
+  List *others = NewList();
+  Setattr(nlist, "named", named);
+  Setattr(nlist, "others", others);
+  Delete(named);
+  Delete(others);
+  return nlist;
+}
+
+static Hash *namewarn_list = 0;
+Hash *Swig_name_namewarn_list() {
   if (!namewarn_list)
-    namewarn_list = NewList();
+    namewarn_list = Swig_name_nameobj_list();
   return namewarn_list;
 }
 
-static List *rename_list = 0;
-List *Swig_name_rename_list() {
+static Hash *rename_list = 0;
+Hash *Swig_name_rename_list() {
   if (!rename_list)
-    rename_list = NewList();
+    rename_list = Swig_name_nameobj_list();
   return rename_list;
 }
 
@@ -1072,7 +1127,8 @@ static void Swig_name_object_attach_keys(const char *keys[], Hash *nameobj) {
   }
 }
 
-void Swig_name_nameobj_add(Hash *name_hash, List *name_list, String *prefix, String *name, SwigType *decl, Hash *nameobj) {
+void Swig_name_nameobj_add(Hash *name_hash, Hash *name_list, String *prefix, String *name, SwigType *decl, Hash *nameobj) {
+  static int serial = 0;
   String *nname = 0;
   if (name && Len(name)) {
     String *target_fmt = Getattr(nameobj, "targetfmt");
@@ -1090,9 +1146,25 @@ void Swig_name_nameobj_add(Hash *name_hash, List *name_list, String *prefix, Str
       Setattr(nameobj, "decl", decl);
     if (nname && Len(nname))
       Setattr(nameobj, "targetname", nname);
-    /* put the new nameobj at the beginnig of the list, such that the
+    SetInt(nameobj, "serial", ++serial);
+    /* put the new nameobj at the beginnig of its list, such that the
        last inserted rule take precedence */
-    Insert(name_list, 0, nameobj);
+    if (nname && Len(nname) && !Getattr(nameobj, "sourcefmt") && !GetFlag(nameobj, "rxstarget")
+#if defined(SWIG_USE_SIMPLE_MATCHOR)
+	&& !Strchr(nname, '|')
+#endif
+	) {
+      Hash *named = Getattr(name_list, "named");
+      List *nlist = Getattr(named, nname);
+      if (!nlist) {
+	nlist = NewList();
+	Setattr(named, nname, nlist);
+	Delete(nlist);
+      }
+      Insert(nlist, 0, nameobj);
+    } else {
+      Insert(Getattr(name_list, "others"), 0, nameobj);
+    }
   } else {
     /* here we add an old 'hash' nameobj, simple and fast */
     Swig_name_object_set(name_hash, nname, decl, nameobj);
@@ -1133,20 +1205,45 @@ static DOH *Swig_get_lattr(Node *n, List *lattr) {
 #endif
 
 #if defined(USE_RXSPENCER)
+/* Patterns are compiled once and kept, as the same rxsmatch/rxstarget
+   patterns are applied to every declaration */
+static Hash *rxs_compiled = 0;
+
+static void rxs_free(void *ptr) {
+  regex_t *compiled = (regex_t *) ptr;
+  regfree(compiled);
+  free(compiled);
+}
+
 int Swig_name_rxsmatch_value(String *mvalue, String *value) {
   int match = 0;
   char *cvalue = Char(value);
   char *cmvalue = Char(mvalue);
-  regex_t compiled;
-  int retval = regcomp(&compiled, cmvalue, REG_EXTENDED | REG_NOSUB);
-  if (retval != 0)
+  regex_t *compiled;
+  int retval;
+  DOH *rx;
+  if (!rxs_compiled)
+    rxs_compiled = NewHash();
+  rx = Getattr(rxs_compiled, mvalue);
+  if (!rx) {
+    compiled = (regex_t *) malloc(sizeof(regex_t));
+    retval = regcomp(compiled, cmvalue, REG_EXTENDED | REG_NOSUB);
+    if (retval != 0) {
+      free(compiled);
+      compiled = 0;
+    }
+    rx = NewVoid(compiled, compiled ? rxs_free : 0);
+    Setattr(rxs_compiled, mvalue, rx);
+    Delete(rx);
+  }
+  compiled = (regex_t *) Data(rx);
+  if (!compiled)
     return 0;
-  retval = regexec(&compiled, cvalue, 0, 0, 0);
+  retval = regexec(compiled, cvalue, 0, 0, 0);
   match = (retval == REG_NOMATCH) ? 0 : 1;
 #ifdef SWIG_DEBUG
   Printf(stdout, "rxsmatch_value: %s %s %d\n", cvalue, cmvalue, match);
 #endif
-  regfree(&compiled);
   return match;
 }
 #else
@@ -1227,55 +1324,88 @@ int Swig_name_match_nameobj(Hash *rn, Node *n) {
 /* -----------------------------------------------------------------------------
  * Hash *Swig_name_nameobj_lget()
  *
- * Get a nameobj (rename/namewarn) from the list of filters
+ * Get a nameobj (rename/namewarn) from the list of filters. Only the
+ * nameobjs indexed under the name (or the prefixed name) and the ones
+ * without a plain target name need to be checked.
  * 
  * ----------------------------------------------------------------------------- */
 
-Hash *Swig_name_nameobj_lget(List *namelist, Node *n, String *prefix, String *name, String *decl) {
-  Hash *res = 0;
+static int Swig_name_nameobj_lmatch(Hash *rn, Node *n, String *prefix, String *name, String *decl) {
+  int match = 0;
+  String *rdecl = Getattr(rn, "decl");
+  if (rdecl && (!decl || !Equal(rdecl, decl))) {
+    return 0;
+  } else if (Swig_name_match_nameobj(rn, n)) {
+    String *tname = Getattr(rn, "targetname");
+    if (tname) {
+      String *sfmt = Getattr(rn, "sourcefmt");
+      String *sname = 0;
+      int fullname = GetFlag(rn, "fullname");
+      int rxstarget = GetFlag(rn, "rxstarget");
+      if (sfmt) {
+	if (fullname && prefix) {
+	  String *pname = NewStringf("%s::%s", prefix, name);
+	  sname = NewStringf(sfmt, pname);
+	  Delete(pname);
+	} else {
+	  sname = NewStringf(sfmt, name);
+	}
+      } else {
+	if (fullname && prefix) {
+	  sname = NewStringf("%s::%s", prefix, name);
+	} else {
+	  sname = name;
+	  DohIncref(name);
+	}
+      }
+      match = rxstarget ? Swig_name_rxsmatch_value(tname, sname) : Swig_name_match_value(tname, sname);
+      Delete(sname);
+    } else {
+      match = 1;
+    }
+  }
+  return match;
+}
+
+/* Returns the first matching nameobj of a list newer than the 'serial' one */
+static Hash *Swig_name_nameobj_lfind(List *namelist, int serial, Node *n, String *prefix, String *name, String *decl) {
   if (namelist) {
     int len = Len(namelist);
     int i;
-    int match = 0;
-    for (i = 0; !match && (i < len); i++) {
+    for (i = 0; i < len; i++) {
       Hash *rn = Getitem(namelist, i);
-      String *rdecl = Getattr(rn, "decl");
-      if (rdecl && (!decl || !Equal(rdecl, decl))) {
-	continue;
-      } else if (Swig_name_match_nameobj(rn, n)) {
-	String *tname = Getattr(rn, "targetname");
-	if (tname) {
-	  String *sfmt = Getattr(rn, "sourcefmt");
-	  String *sname = 0;
-	  int fullname = GetFlag(rn, "fullname");
-	  int rxstarget = GetFlag(rn, "rxstarget");
-	  if (sfmt) {
-	    if (fullname && prefix) {
-	      String *pname = NewStringf("%s::%s", prefix, name);
-	      sname = NewStringf(sfmt, pname);
-	      Delete(pname);
-	    } else {
-	      sname = NewStringf(sfmt, name);
-	    }
-	  } else {
-	    if (fullname && prefix) {
-	      sname = NewStringf("%s::%s", prefix, name);
-	    } else {
-	      sname = name;
-	      DohIncref(name);
-	    }
-	  }
-	  match = rxstarget ? Swig_name_rxsmatch_value(tname, sname) : Swig_name_match_value(tname, sname);
-	  Delete(sname);
-	} else {
-	  match = 1;
-	}
-      }
-      if (match) {
-	res = rn;
+      if (GetInt(rn, "serial") <= serial)
 	break;
+      if (Swig_name_nameobj_lmatch(rn, n, prefix, name, decl))
+	return rn;
+    }
+  }
+  return 0;
+}
+
+Hash *Swig_name_nameobj_lget(Hash *namelist, Node *n, String *prefix, String *name, String *decl) {
+  Hash *res = 0;
+  if (namelist) {
+    Hash *named = Getattr(namelist, "named");
+    Hash *rn;
+    int serial = 0;
+    if (name) {
+      res = Swig_name_nameobj_lfind(Getattr(named, name), 0, n, prefix, name, decl);
+      if (res)
+	serial = GetInt(res, "serial");
+      if (prefix) {
+	String *pname = NewStringf("%s::%s", prefix, name);
+	rn = Swig_name_nameobj_lfind(Getattr(named, pname), serial, n, prefix, name, decl);
+	if (rn) {
+	  res = rn;
+	  serial = GetInt(res, "serial");
+	}
+	Delete(pname);
       }
     }
+    rn = Swig_name_nameobj_lfind(Getattr(namelist, "others"), serial, n, prefix, name, decl);
+    if (rn)
+      res = rn;
   }
   return res;
 }
@@ -505,6 +505,10 @@ String *SwigType_namestr(const SwigType *t) {
   if (!c || !strstr(c + 2, ")>"))
     return NewString(t);
 
+  r = SwigType_getform(t, "namestr");
+  if (r)
+    return r;
+
   r = NewStringWithSize(d, c - d);
   if (*(c - 1) == '<')
     Putc(' ', r);
@@ -528,6 +532,7 @@ String *SwigType_namestr(const SwigType *t) {
   Append(r, suffix);
   Delete(suffix);
   Delete(p);
+  SwigType_setform(t, "namestr", r);
   return r;
 }
 
@@ -543,6 +548,13 @@ String *SwigType_str(SwigType *s, const_String_or_char_ptr id) {
   List *elements;
   int nelements, i;
 
+  /* The string of an unnamed type is remembered */
+  if (!id || !Len(id)) {
+    result = SwigType_getform(s, "str");
+    if (result)
+      return result;
+  }
+
   if (id) {
     result = NewString(id);
   } else {
@@ -625,6 +637,8 @@ String *SwigType_str(SwigType *s, const_String_or_char_ptr id) {
   }
   Delete(elements);
   Chop(result);
+  if (!id || !Len(id))
+    SwigType_setform(s, "str", result);
   return result;
 }
 
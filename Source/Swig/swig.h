@@ -153,6 +153,8 @@ extern "C" {
   extern int SwigType_isenum(SwigType *t);
   extern int SwigType_check_decl(SwigType *t, const_String_or_char_ptr decl);
   extern SwigType *SwigType_strip_qualifiers(SwigType *t);
+  extern String *SwigType_getform(const SwigType *t, const char *form);
+  extern void SwigType_setform(const SwigType *t, const char *form, const String *value);
   extern SwigType *SwigType_functionpointer_decompose(SwigType *t);
   extern String *SwigType_base(const SwigType *t);
   extern String *SwigType_namestr(const SwigType *t);
@@ -279,6 +281,8 @@ extern int        ParmList_is_compactdefargs(ParmList *p);
   extern void Swig_name_object_inherit(Hash *namehash, String *base, String *derived);
   extern void Swig_features_get(Hash *features, String *prefix, String *name, SwigType *decl, Node *n);
   extern void Swig_feature_set(Hash *features, const_String_or_char_ptr name, SwigType *decl, const_String_or_char_ptr featurename, String *value, Hash *featureattribs);
+  extern void Swig_features_debug_set(int on);
+  extern void Swig_features_debug(void);
 
 /* --- Misc --- */
   extern char *Swig_copy_string(const char *c);
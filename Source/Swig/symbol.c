@@ -99,6 +99,9 @@ char cvsroot_symbol_c[] = "$Id$";
  *                       %renaming operations
  *     symtab         -- Hash table mapping identifiers to nodes.
  *     csymtab        -- Hash table mapping C identifiers to nodes.
+ *     qname          -- Cached fully qualified scope name
+ *     clookup        -- Cache of Swig_symbol_clookup() results from this scope
+ *     tlookup        -- Cache of the lookups made by Swig_symbol_type_qualify()
  *
  * Reserved attributes on symbol objects:
  *
@@ -172,6 +175,12 @@ static Hash *current_symtab = 0;	/* Current symbol table node */
 static Hash *symtabs = 0;	/* Hash of all symbol tables by fully-qualified name */
 static Hash *global_scope = 0;	/* Global scope */
 
+static List *lookup_cached = 0;	/* Symbol tables holding a lookup cache */
+static Hash *scopename_splits = 0;	/* Qualified names already split into prefix and base */
+static String *lookup_none = 0;	/* Cached value meaning 'nothing found' */
+static int lookup_depth = 0;	/* Nesting of symbol_lookup() calls */
+static int lookup_using = 0;	/* Set when a lookup followed a using declaration */
+
 /* common attribute keys, to avoid calling find_key all the times */
 
 
@@ -212,6 +221,41 @@ void Swig_symbol_init() {
   Setattr(symtabs, "", current_symtab);
   Delete(current_symtab);
   global_scope = current_symtab;
+
+  lookup_cached = NewList();
+  scopename_splits = NewHash();
+  lookup_none = NewStringEmpty();
+}
+
+/* -----------------------------------------------------------------------------
+ * symbol_lookup_forget()
+ *
+ * Throw away the cached lookups of all symbol tables.  This must be called
+ * whenever a symbol table is changed in a way that can affect a C lookup.
+ * ----------------------------------------------------------------------------- */
+
+static void symbol_lookup_forget(void) {
+  int i, len = Len(lookup_cached);
+  for (i = 0; i < len; i++) {
+    Symtab *st = Getitem(lookup_cached, i);
+    Delattr(st, "clookup");
+    Delattr(st, "tlookup");
+  }
+  Clear(lookup_cached);
+}
+
+/* -----------------------------------------------------------------------------
+ * symbol_qname_forget()
+ *
+ * Throw away the cached qualified name of a symbol table and its nested scopes.
+ * ----------------------------------------------------------------------------- */
+
+static void symbol_qname_forget(Symtab *symtab) {
+  Node *c;
+  Delattr(symtab, "qname");
+  for (c = firstChild(symtab); c; c = nextSibling(c)) {
+    symbol_qname_forget(c);
+  }
 }
 
 /* -----------------------------------------------------------------------------
@@ -224,6 +268,8 @@ void Swig_symbol_setscopename(const_String_or_char_ptr name) {
   String *qname;
   /* assert(!Getattr(current_symtab,"name")); */
   Setattr(current_symtab, "name", name);
+  symbol_qname_forget(current_symtab);
+  symbol_lookup_forget();
 
   /* Set nested scope in parent */
 
@@ -262,15 +308,21 @@ Symtab *Swig_symbol_getscope(const_String_or_char_ptr name) {
  * Swig_symbol_qualifiedscopename()
  *
  * Get the fully qualified C scopename of a symbol table.  Note, this only pertains
- * to the C/C++ scope name.  It is not affected by renaming.
+ * to the C/C++ scope name.  It is not affected by renaming.  The name is
+ * remembered in the symbol table until Swig_symbol_setscopename() changes it.
  * ----------------------------------------------------------------------------- */
 
 String *Swig_symbol_qualifiedscopename(Symtab *symtab) {
   String *result = 0;
+  String *cached;
   Hash *parent;
   String *name;
   if (!symtab)
     symtab = current_symtab;
+  cached = Getattr(symtab, "qname");
+  if (cached) {
+    return cached == lookup_none ? 0 : Copy(cached);
+  }
   parent = Getattr(symtab, "parentNode");
   if (parent) {
     result = Swig_symbol_qualifiedscopename(parent);
@@ -286,6 +338,13 @@ String *Swig_symbol_qualifiedscopename(Symtab *symtab) {
       Append(result, name);
     }
   }
+  if (result) {
+    cached = Copy(result);
+    Setattr(symtab, "qname", cached);
+    Delete(cached);
+  } else {
+    Setattr(symtab, "qname", lookup_none);
+  }
   return result;
 }
 
@@ -382,6 +441,7 @@ void Swig_symbol_alias(const_String_or_char_ptr aliasname, Symtab *s) {
   }
   if (!Getattr(symtabs, qname)) {
     Setattr(symtabs, qname, s);
+    symbol_lookup_forget();
   }
   Delete(qname);
 }
@@ -413,6 +473,7 @@ void Swig_symbol_inherit(Symtab *s) {
       return;			/* Already inherited */
   }
   Append(inherit, s);
+  symbol_lookup_forget();
 }
 
 /* -----------------------------------------------------------------------------
@@ -455,6 +516,7 @@ void Swig_symbol_cadd(const_String_or_char_ptr name, Node *n) {
 #ifdef SWIG_DEBUG
   Printf(stderr, "symbol_cadd %s %x\n", name, n);
 #endif
+  symbol_lookup_forget();
   cn = Getattr(ccurrent, name);
 
   if (cn && (Getattr(cn, "sym:typename"))) {
@@ -892,6 +954,9 @@ static Node *_symbol_lookup(const String *name, Symtab *symtab, int (*check) (No
 
 static Node *symbol_lookup(const_String_or_char_ptr name, Symtab *symtab, int (*check) (Node *n)) {
   Node *n = 0;
+  /* Symbol tables are marked while they are searched, so nested lookups
+     made from here may miss symbols and must not be cached */
+  lookup_depth++;
   if (DohCheck(name)) {
     n = _symbol_lookup(name, symtab, check);
   } else {
@@ -899,6 +964,7 @@ static Node *symbol_lookup(const_String_or_char_ptr name, Symtab *symtab, int (*
     n = _symbol_lookup(sname, symtab, check);
     Delete(sname);
   }
+  lookup_depth--;
   return n;
 }
 
@@ -914,14 +980,24 @@ static Node *symbol_lookup_qualified(const_String_or_char_ptr name, Symtab *symt
   if (!symtab)
     return 0;
   if (!prefix) {
-    Node *n;
+    List *split = Getattr(scopename_splits, name);
     String *bname;
     String *prefix;
-    Swig_scopename_split(name, &prefix, &bname);
-    n = symbol_lookup_qualified(bname, symtab, prefix, local, checkfunc);
-    Delete(bname);
-    Delete(prefix);
-    return n;
+    if (!split) {
+      String *key = NewString(name);
+      Swig_scopename_split(name, &prefix, &bname);
+      split = NewList();
+      Append(split, prefix ? prefix : lookup_none);
+      Append(split, bname);
+      Setattr(scopename_splits, key, split);
+      Delete(split);
+      Delete(key);
+      Delete(prefix);
+      Delete(bname);
+    }
+    prefix = Getitem(split, 0);
+    bname = Getitem(split, 1);
+    return symbol_lookup_qualified(bname, symtab, prefix == lookup_none ? 0 : prefix, local, checkfunc);
   } else {
     Symtab *st;
     Node *n = 0;
@@ -968,6 +1044,56 @@ static Node *symbol_lookup_qualified(const_String_or_char_ptr name, Symtab *symt
   }
 }
 
+/* -----------------------------------------------------------------------------
+ * symbol_clookup_cached()
+ *
+ * Looks up a symbol with the given lookup function, remembering the result in
+ * the cache named by attr in the symbol table the search starts from.  Only
+ * top level lookups of non-template names are cached: template names are
+ * expanded relative to the current scope and lookups nested in symbol_lookup()
+ * see partially marked symbol tables.  Lookups which followed a using
+ * declaration are not cached either, so that its warnings are still issued.
+ * ----------------------------------------------------------------------------- */
+
+static Node *symbol_clookup_cached(const_String_or_char_ptr name, Symtab *n, const char *attr, Node *(*lookup) (const_String_or_char_ptr name, Symtab *n, int (*checkfunc) (Node *n)), int (*checkfunc) (Node *n)) {
+  Symtab *hsym = 0;
+  Hash *cache;
+  Node *s;
+  int using_seen = lookup_using;
+
+  if (!lookup_depth && !SwigType_istemplate(name)) {
+    hsym = n;
+    if (!hsym) {
+      hsym = current_symtab;
+    } else if (!Checkattr(hsym, "nodeType", "symboltable")) {
+      hsym = Getattr(hsym, "sym:symtab");
+    }
+    cache = hsym ? Getattr(hsym, attr) : 0;
+    if (cache) {
+      s = Getattr(cache, name);
+      if (s)
+	return s == lookup_none ? 0 : s;
+    }
+  }
+
+  lookup_using = 0;
+  s = lookup(name, n, checkfunc);
+  if (hsym && !lookup_using) {
+    String *key = NewString(name);
+    cache = Getattr(hsym, attr);
+    if (!cache) {
+      cache = NewHash();
+      Setattr(hsym, attr, cache);
+      Delete(cache);
+      Append(lookup_cached, hsym);
+    }
+    Setattr(cache, key, s ? s : lookup_none);
+    Delete(key);
+  }
+  lookup_using |= using_seen;
+  return s;
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_symbol_clookup()
  *
@@ -976,9 +1102,10 @@ static Node *symbol_lookup_qualified(const_String_or_char_ptr name, Symtab *symt
  * to get the real node.
  * ----------------------------------------------------------------------------- */
 
-Node *Swig_symbol_clookup(const_String_or_char_ptr name, Symtab *n) {
+static Node *symbol_clookup(const_String_or_char_ptr name, Symtab *n, int (*checkfunc) (Node *n)) {
   Hash *hsym = 0;
   Node *s = 0;
+  (void) checkfunc;		/* only takes it to be usable with symbol_clookup_cached() */
 
   if (!n) {
     hsym = current_symtab;
@@ -1029,7 +1156,9 @@ Node *Swig_symbol_clookup(const_String_or_char_ptr name, Symtab *n) {
   while (s && Checkattr(s, "nodeType", "using")) {
     String *uname = Getattr(s, "uname");
     Symtab *un = Getattr(s, "sym:symtab");
-    Node *ss = (!Equal(name, uname) || (un != n)) ? Swig_symbol_clookup(uname, un) : 0;	/* avoid infinity loop */
+    Node *ss;
+    lookup_using = 1;
+    ss = (!Equal(name, uname) || (un != n)) ? Swig_symbol_clookup(uname, un) : 0;	/* avoid infinity loop */
     if (!ss) {
       Swig_warning(WARN_PARSE_USING_UNDEF, Getfile(s), Getline(s), "Nothing known about '%s'.\n", Getattr(s, "uname"));
     }
@@ -1038,6 +1167,10 @@ Node *Swig_symbol_clookup(const_String_or_char_ptr name, Symtab *n) {
   return s;
 }
 
+Node *Swig_symbol_clookup(const_String_or_char_ptr name, Symtab *n) {
+  return symbol_clookup_cached(name, n, "clookup", symbol_clookup, 0);
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_symbol_clookup_check()
  *
@@ -1048,7 +1181,7 @@ Node *Swig_symbol_clookup(const_String_or_char_ptr name, Symtab *n) {
  * inheritance hierarchy. 
  * ----------------------------------------------------------------------------- */
 
-Node *Swig_symbol_clookup_check(const_String_or_char_ptr name, Symtab *n, int (*checkfunc) (Node *n)) {
+static Node *symbol_clookup_check(const_String_or_char_ptr name, Symtab *n, int (*checkfunc) (Node *n)) {
   Hash *hsym = 0;
   Node *s = 0;
 
@@ -1099,6 +1232,7 @@ Node *Swig_symbol_clookup_check(const_String_or_char_ptr name, Symtab *n, int (*
   /* Check if s is a 'using' node */
   while (s && Checkattr(s, "nodeType", "using")) {
     Node *ss;
+    lookup_using = 1;
     ss = Swig_symbol_clookup(Getattr(s, "uname"), Getattr(s, "sym:symtab"));
     if (!ss && !checkfunc) {
       Swig_warning(WARN_PARSE_USING_UNDEF, Getfile(s), Getline(s), "Nothing known about '%s'.\n", Getattr(s, "uname"));
@@ -1108,6 +1242,17 @@ Node *Swig_symbol_clookup_check(const_String_or_char_ptr name, Symtab *n, int (*
   return s;
 }
 
+static int no_constructor(Node *n) {
+  return !Checkattr(n, "nodeType", "constructor");
+}
+
+Node *Swig_symbol_clookup_check(const_String_or_char_ptr name, Symtab *n, int (*checkfunc) (Node *n)) {
+  /* Other check functions may depend on state outside the symbol tables */
+  if (checkfunc == no_constructor)
+    return symbol_clookup_cached(name, n, "tlookup", symbol_clookup_check, checkfunc);
+  return symbol_clookup_check(name, n, checkfunc);
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_symbol_clookup_local()
  * ----------------------------------------------------------------------------- */
@@ -1147,7 +1292,9 @@ Node *Swig_symbol_clookup_local(const_String_or_char_ptr name, Symtab *n) {
     return 0;
   /* Check if s is a 'using' node */
   while (s && Checkattr(s, "nodeType", "using")) {
-    Node *ss = Swig_symbol_clookup_local(Getattr(s, "uname"), Getattr(s, "sym:symtab"));
+    Node *ss;
+    lookup_using = 1;
+    ss = Swig_symbol_clookup_local(Getattr(s, "uname"), Getattr(s, "sym:symtab"));
     if (!ss) {
       Swig_warning(WARN_PARSE_USING_UNDEF, Getfile(s), Getline(s), "Nothing known about '%s'.\n", Getattr(s, "uname"));
     }
@@ -1195,7 +1342,9 @@ Node *Swig_symbol_clookup_local_check(const_String_or_char_ptr name, Symtab *n,
     return 0;
   /* Check if s is a 'using' node */
   while (s && Checkattr(s, "nodeType", "using")) {
-    Node *ss = Swig_symbol_clookup_local_check(Getattr(s, "uname"), Getattr(s, "sym:symtab"), checkfunc);
+    Node *ss;
+    lookup_using = 1;
+    ss = Swig_symbol_clookup_local_check(Getattr(s, "uname"), Getattr(s, "sym:symtab"), checkfunc);
     if (!ss && !checkfunc) {
       Swig_warning(WARN_PARSE_USING_UNDEF, Getfile(s), Getline(s), "Nothing known about '%s'.\n", Getattr(s, "uname"));
     }
@@ -1238,6 +1387,7 @@ void Swig_symbol_remove(Node *n) {
   symname = Getattr(n, "sym:name");
   symprev = Getattr(n, "sym:previousSibling");
   symnext = Getattr(n, "sym:nextSibling");
+  symbol_lookup_forget();
 
   /* If previous symbol, just fix the links */
   if (symprev) {
@@ -1401,10 +1551,6 @@ static SwigType *Swig_symbol_template_qualify(const SwigType *e, Symtab *st) {
 }
 
 
-static int no_constructor(Node *n) {
-  return !Checkattr(n, "nodeType", "constructor");
-}
-
 SwigType *Swig_symbol_type_qualify(const SwigType *t, Symtab *st) {
   List *elements;
   String *result = NewStringEmpty();
@@ -170,6 +170,78 @@ Hash *Swig_typemap_pop_scope() {
 }
 #endif
 
+/* -----------------------------------------------------------------------------
+ * typemap_scan_vars()
+ *
+ * Makes one pass over typemap code looking for the special variables that
+ * typemap_replace_vars() substitutes and returns them as a set of TMVAR flags.
+ * Variables are matched on their prefix, the same as the DOH_REPLACE_ANY
+ * substitutions, so the flags may include variables which are not really
+ * used, but never miss one which is.
+ * ----------------------------------------------------------------------------- */
+
+#define TMVAR_DIM       0x001	/* $dimN, $n_dimN */
+#define TMVAR_SIZE      0x002	/* $n_size */
+#define TMVAR_PARMNAME  0x004	/* $parmname */
+#define TMVAR_NAME      0x008	/* $n_name */
+#define TMVAR_TYPE      0x010	/* $type, $n_type */
+#define TMVAR_LTYPE     0x020	/* $ltype, $n_ltype */
+#define TMVAR_MANGLE    0x040	/* $mangle, $n_mangle, $descriptor, $n_descriptor */
+#define TMVAR_STAR      0x080	/* $*type, $*n_type, $*ltype, $*n_ltype, ... */
+#define TMVAR_AMP       0x100	/* $&type, $&n_type, $&ltype, $&n_ltype, ... */
+#define TMVAR_BASE      0x200	/* $basetype, $n_basetype, $basemangle, $n_basemangle */
+#define TMVAR_LEXTYPE   0x400	/* $lextype, $n_lextype */
+#define TMVAR_ALL       0x7ff
+#define TMVAR_TYPES     (TMVAR_ALL & ~(TMVAR_PARMNAME | TMVAR_NAME))	/* Variables that depend on the type */
+
+static int typemap_scan_vars(const char *c) {
+  int vars = 0;
+  while (c && (c = strchr(c, '$'))) {
+    c++;
+    if (*c == '*') {
+      vars |= TMVAR_STAR;
+      continue;
+    }
+    if (*c == '&') {
+      vars |= TMVAR_AMP;
+      continue;
+    }
+    while (isdigit((int) *c))
+      c++;
+    if (*c == '_')
+      c++;
+    if (strncmp(c, "dim", 3) == 0)
+      vars |= TMVAR_DIM;
+    else if (strncmp(c, "size", 4) == 0)
+      vars |= TMVAR_SIZE;
+    else if (strncmp(c, "parmname", 8) == 0)
+      vars |= TMVAR_PARMNAME;
+    else if (strncmp(c, "name", 4) == 0)
+      vars |= TMVAR_NAME;
+    else if (strncmp(c, "type", 4) == 0)
+      vars |= TMVAR_TYPE;
+    else if (strncmp(c, "ltype", 5) == 0)
+      vars |= TMVAR_LTYPE;
+    else if ((strncmp(c, "mangle", 6) == 0) || (strncmp(c, "descriptor", 10) == 0))
+      vars |= TMVAR_MANGLE;
+    else if (strncmp(c, "base", 4) == 0)
+      vars |= TMVAR_BASE;
+    else if (strncmp(c, "lextype", 7) == 0)
+      vars |= TMVAR_LEXTYPE;
+  }
+  return vars;
+}
+
+/* Special variables used in typemap code or in the types of its local variables */
+static int typemap_vars(const_String_or_char_ptr code, ParmList *locals) {
+  int vars = typemap_scan_vars(Char(code));
+  while (locals) {
+    vars |= typemap_scan_vars(GetChar(locals, "type"));
+    locals = nextSibling(locals);
+  }
+  return vars;
+}
+
 /* ----------------------------------------------------------------------------- 
  * Swig_typemap_register()
  *
@@ -258,6 +330,7 @@ void Swig_typemap_register(const_String_or_char_ptr tmap_method, ParmList *parms
     String *typemap = NewStringf("typemap(%s) %s", tmap_method, str);
     ParmList *clocals = CopyParmList(locals);
     ParmList *ckwargs = CopyParmList(kwargs);
+    int vars = typemap_vars(code, clocals);
 
     Setattr(tm2, "code", code);
     Setattr(tm2, "type", type);
@@ -267,6 +340,7 @@ void Swig_typemap_register(const_String_or_char_ptr tmap_method, ParmList *parms
     }
     Setattr(tm2, "locals", clocals);
     Setattr(tm2, "kwargs", ckwargs);
+    SetInt(tm2, "vars", vars);
 
     Delete(clocals);
     Delete(ckwargs);
@@ -800,28 +874,24 @@ static void replace_local_types(ParmList *p, const String *name, const String *r
   }
 }
 
-static int check_locals(ParmList *p, const char *s) {
-  while (p) {
-    char *c = GetChar(p, "type");
-    if (strstr(c, s))
-      return 1;
-    p = nextSibling(p);
-  }
-  return 0;
-}
-
-static int typemap_replace_vars(String *s, ParmList *locals, SwigType *type, SwigType *rtype, String *pname, String *lname, int index) {
+static int typemap_replace_vars(String *s, ParmList *locals, SwigType *type, SwigType *rtype, String *pname, String *lname, int index, int vars) {
   char var[512];
   char *varname;
-  SwigType *ftype;
+  SwigType *ftype = 0;
   int bare_substitution_count = 0;
 
-  Replaceall(s, "$typemap", "$TYPEMAP"); /* workaround for $type substitution below */
-
-  ftype = SwigType_typedef_resolve_all(type);
-
   if (!pname)
     pname = lname;
+
+  /* Names which themselves contain a $ could introduce more special variables */
+  if ((pname && Strchr(pname, '$')) || (lname && Strchr(lname, '$')))
+    vars = TMVAR_ALL;
+
+  if (vars & TMVAR_TYPE)
+    Replaceall(s, "$typemap", "$TYPEMAP"); /* workaround for $type substitution below */
+
+  if (vars & TMVAR_TYPES)
+    ftype = SwigType_typedef_resolve_all(type);
   {
     Parm *p;
     int rep = 0;
@@ -841,7 +911,7 @@ static int typemap_replace_vars(String *s, ParmList *locals, SwigType *type, Swi
   /* If the original datatype was an array. We're going to go through and substitute
      its array dimensions */
 
-  if (SwigType_isarray(type) || SwigType_isarray(ftype)) {
+  if (ftype && (SwigType_isarray(type) || SwigType_isarray(ftype))) {
     String *size;
     int ndim;
     int i;
@@ -872,24 +942,23 @@ static int typemap_replace_vars(String *s, ParmList *locals, SwigType *type, Swi
   }
 
   /* Parameter name substitution */
-  if (index == 1) {
+  if ((vars & TMVAR_PARMNAME) && (index == 1)) {
     Replace(s, "$parmname", pname, DOH_REPLACE_ANY);
   }
-  strcpy(varname, "name");
-  Replace(s, var, pname, DOH_REPLACE_ANY);
+  if (vars & TMVAR_NAME) {
+    strcpy(varname, "name");
+    Replace(s, var, pname, DOH_REPLACE_ANY);
+  }
 
   /* Type-related stuff */
-  {
+  if (vars & TMVAR_TYPES) {
     SwigType *star_type, *amp_type, *base_type, *lex_type;
     SwigType *ltype, *star_ltype, *amp_ltype;
     String *mangle, *star_mangle, *amp_mangle, *base_mangle, *base_name;
     String *descriptor, *star_descriptor, *amp_descriptor;
     String *ts;
-    char *sc;
-
-    sc = Char(s);
 
-    if (strstr(sc, "type") || check_locals(locals, "type")) {
+    if (vars & TMVAR_TYPE) {
       /* Given type : $type */
       ts = SwigType_str(type, 0);
       if (index == 1) {
@@ -900,9 +969,8 @@ static int typemap_replace_vars(String *s, ParmList *locals, SwigType *type, Swi
       Replace(s, var, ts, DOH_REPLACE_ANY);
       replace_local_types(locals, var, type);
       Delete(ts);
-      sc = Char(s);
     }
-    if (strstr(sc, "ltype") || check_locals(locals, "ltype")) {
+    if (vars & TMVAR_LTYPE) {
       /* Local type:  $ltype */
       ltype = SwigType_ltype(type);
       ts = SwigType_str(ltype, 0);
@@ -915,9 +983,8 @@ static int typemap_replace_vars(String *s, ParmList *locals, SwigType *type, Swi
       replace_local_types(locals, var, ltype);
       Delete(ts);
       Delete(ltype);
-      sc = Char(s);
     }
-    if (strstr(sc, "mangle") || strstr(sc, "descriptor")) {
+    if (vars & TMVAR_MANGLE) {
       /* Mangled type */
 
       mangle = SwigType_manglestr(type);
@@ -946,7 +1013,7 @@ static int typemap_replace_vars(String *s, ParmList *locals, SwigType *type, Swi
        $*n_ltype
      */
 
-    if (SwigType_ispointer(ftype) || (SwigType_isarray(ftype)) || (SwigType_isreference(ftype))) {
+    if ((vars & TMVAR_STAR) && (SwigType_ispointer(ftype) || (SwigType_isarray(ftype)) || (SwigType_isreference(ftype)))) {
       if (!(SwigType_isarray(type) || SwigType_ispointer(type) || SwigType_isreference(type))) {
 	star_type = Copy(ftype);
       } else {
@@ -1005,84 +1072,90 @@ static int typemap_replace_vars(String *s, ParmList *locals, SwigType *type, Swi
          requested */
     }
     /* One pointer level added */
-    amp_type = Copy(type);
-    SwigType_add_pointer(amp_type);
-    ts = SwigType_str(amp_type, 0);
-    if (index == 1) {
-      Replace(s, "$&type", ts, DOH_REPLACE_ANY);
-      replace_local_types(locals, "$&type", amp_type);
-    }
-    sprintf(varname, "$&%d_type", index);
-    Replace(s, varname, ts, DOH_REPLACE_ANY);
-    replace_local_types(locals, varname, amp_type);
-    Delete(ts);
-
-    amp_ltype = SwigType_ltype(type);
-    SwigType_add_pointer(amp_ltype);
-    ts = SwigType_str(amp_ltype, 0);
-
-    if (index == 1) {
-      Replace(s, "$&ltype", ts, DOH_REPLACE_ANY);
-      replace_local_types(locals, "$&ltype", amp_ltype);
-    }
-    sprintf(varname, "$&%d_ltype", index);
-    Replace(s, varname, ts, DOH_REPLACE_ANY);
-    replace_local_types(locals, varname, amp_ltype);
-    Delete(ts);
-    Delete(amp_ltype);
-
-    amp_mangle = SwigType_manglestr(amp_type);
-    if (index == 1)
-      Replace(s, "$&mangle", amp_mangle, DOH_REPLACE_ANY);
-    sprintf(varname, "$&%d_mangle", index);
-    Replace(s, varname, amp_mangle, DOH_REPLACE_ANY);
-
-    amp_descriptor = NewStringf("SWIGTYPE%s", amp_mangle);
-    if (index == 1)
-      if (Replace(s, "$&descriptor", amp_descriptor, DOH_REPLACE_ANY))
+    if (vars & TMVAR_AMP) {
+      amp_type = Copy(type);
+      SwigType_add_pointer(amp_type);
+      ts = SwigType_str(amp_type, 0);
+      if (index == 1) {
+	Replace(s, "$&type", ts, DOH_REPLACE_ANY);
+	replace_local_types(locals, "$&type", amp_type);
+      }
+      sprintf(varname, "$&%d_type", index);
+      Replace(s, varname, ts, DOH_REPLACE_ANY);
+      replace_local_types(locals, varname, amp_type);
+      Delete(ts);
+
+      amp_ltype = SwigType_ltype(type);
+      SwigType_add_pointer(amp_ltype);
+      ts = SwigType_str(amp_ltype, 0);
+
+      if (index == 1) {
+	Replace(s, "$&ltype", ts, DOH_REPLACE_ANY);
+	replace_local_types(locals, "$&ltype", amp_ltype);
+      }
+      sprintf(varname, "$&%d_ltype", index);
+      Replace(s, varname, ts, DOH_REPLACE_ANY);
+      replace_local_types(locals, varname, amp_ltype);
+      Delete(ts);
+      Delete(amp_ltype);
+
+      amp_mangle = SwigType_manglestr(amp_type);
+      if (index == 1)
+	Replace(s, "$&mangle", amp_mangle, DOH_REPLACE_ANY);
+      sprintf(varname, "$&%d_mangle", index);
+      Replace(s, varname, amp_mangle, DOH_REPLACE_ANY);
+
+      amp_descriptor = NewStringf("SWIGTYPE%s", amp_mangle);
+      if (index == 1)
+	if (Replace(s, "$&descriptor", amp_descriptor, DOH_REPLACE_ANY))
+	  SwigType_remember(amp_type);
+      sprintf(varname, "$&%d_descriptor", index);
+      if (Replace(s, varname, amp_descriptor, DOH_REPLACE_ANY))
 	SwigType_remember(amp_type);
-    sprintf(varname, "$&%d_descriptor", index);
-    if (Replace(s, varname, amp_descriptor, DOH_REPLACE_ANY))
-      SwigType_remember(amp_type);
 
-    Delete(amp_descriptor);
-    Delete(amp_mangle);
-    Delete(amp_type);
+      Delete(amp_descriptor);
+      Delete(amp_mangle);
+      Delete(amp_type);
+    }
 
     /* Base type */
-    if (SwigType_isarray(type)) {
-      SwigType *bt = Copy(type);
-      Delete(SwigType_pop_arrays(bt));
-      base_type = SwigType_str(bt, 0);
-      Delete(bt);
-    } else {
-      base_type = SwigType_base(type);
+    if (vars & TMVAR_BASE) {
+      if (SwigType_isarray(type)) {
+	SwigType *bt = Copy(type);
+	Delete(SwigType_pop_arrays(bt));
+	base_type = SwigType_str(bt, 0);
+	Delete(bt);
+      } else {
+	base_type = SwigType_base(type);
+      }
+
+      base_name = SwigType_namestr(base_type);
+      if (index == 1) {
+	Replace(s, "$basetype", base_name, DOH_REPLACE_ANY);
+	replace_local_types(locals, "$basetype", base_name);
+      }
+      strcpy(varname, "basetype");
+      Replace(s, var, base_type, DOH_REPLACE_ANY);
+      replace_local_types(locals, var, base_name);
+
+      base_mangle = SwigType_manglestr(base_type);
+      if (index == 1)
+	Replace(s, "$basemangle", base_mangle, DOH_REPLACE_ANY);
+      strcpy(varname, "basemangle");
+      Replace(s, var, base_mangle, DOH_REPLACE_ANY);
+      Delete(base_mangle);
+      Delete(base_type);
+      Delete(base_name);
     }
 
-    base_name = SwigType_namestr(base_type);
-    if (index == 1) {
-      Replace(s, "$basetype", base_name, DOH_REPLACE_ANY);
-      replace_local_types(locals, "$basetype", base_name);
+    if (vars & TMVAR_LEXTYPE) {
+      lex_type = SwigType_base(rtype);
+      if (index == 1)
+	Replace(s, "$lextype", lex_type, DOH_REPLACE_ANY);
+      strcpy(varname, "lextype");
+      Replace(s, var, lex_type, DOH_REPLACE_ANY);
+      Delete(lex_type);
     }
-    strcpy(varname, "basetype");
-    Replace(s, var, base_type, DOH_REPLACE_ANY);
-    replace_local_types(locals, var, base_name);
-
-    base_mangle = SwigType_manglestr(base_type);
-    if (index == 1)
-      Replace(s, "$basemangle", base_mangle, DOH_REPLACE_ANY);
-    strcpy(varname, "basemangle");
-    Replace(s, var, base_mangle, DOH_REPLACE_ANY);
-    Delete(base_mangle);
-    Delete(base_type);
-    Delete(base_name);
-
-    lex_type = SwigType_base(rtype);
-    if (index == 1)
-      Replace(s, "$lextype", lex_type, DOH_REPLACE_ANY);
-    strcpy(varname, "lextype");
-    Replace(s, var, lex_type, DOH_REPLACE_ANY);
-    Delete(lex_type);
   }
 
   /* Replace any $n. with (&n)-> */
@@ -1334,9 +1407,9 @@ static String *Swig_typemap_lookup_impl(const_String_or_char_ptr tmap_method, No
   }
 
   if (mtype && SwigType_isarray(mtype)) {
-    num_substitutions = typemap_replace_vars(s, locals, mtype, type, pname, (char *) lname, 1);
+    num_substitutions = typemap_replace_vars(s, locals, mtype, type, pname, (char *) lname, 1, GetInt(tm, "vars"));
   } else {
-    num_substitutions = typemap_replace_vars(s, locals, type, type, pname, (char *) lname, 1);
+    num_substitutions = typemap_replace_vars(s, locals, type, type, pname, (char *) lname, 1, GetInt(tm, "vars"));
   }
   if (optimal_substitution && num_substitutions > 1)
     Swig_warning(WARN_TYPEMAP_OUT_OPTIMAL_MULTIPLE, Getfile(node), Getline(node), "Multiple calls to %s might be generated due to optimal attribute usage in the out typemap at %s:%d.\n", Swig_name_decl(node), Getfile(s), Getline(s));
@@ -1518,6 +1591,7 @@ void Swig_typemap_attach_parms(const_String_or_char_ptr tmap_method, ParmList *p
   int i;
   String *s;
   ParmList *locals;
+  int vars;
   int argnum = 0;
   char temp[256];
   char *cop = Char(tmap_method);
@@ -1612,6 +1686,7 @@ void Swig_typemap_attach_parms(const_String_or_char_ptr tmap_method, ParmList *p
     }
 
     s = Copy(s);
+    vars = GetInt(tm, "vars");
     locals = Getattr(tm, "locals");
     if (locals)
       locals = CopyParmList(locals);
@@ -1632,10 +1707,10 @@ void Swig_typemap_attach_parms(const_String_or_char_ptr tmap_method, ParmList *p
       mtype = Getattr(p, "tmap:match");
 
       if (mtype) {
-	typemap_replace_vars(s, locals, mtype, type, pname, lname, i + 1);
+	typemap_replace_vars(s, locals, mtype, type, pname, lname, i + 1, vars);
 	Delattr(p, "tmap:match");
       } else {
-	typemap_replace_vars(s, locals, type, type, pname, lname, i + 1);
+	typemap_replace_vars(s, locals, type, type, pname, lname, i + 1, vars);
       }
 
       if (Checkattr(tm, "type", "SWIGTYPE")) {
@@ -116,6 +116,55 @@ SwigType *NewSwigType(const_String_or_char_ptr initial) {
 
 #endif
 
+/* -----------------------------------------------------------------------------
+ * SwigType_getform()
+ * SwigType_setform()
+ *
+ * Some forms of a type, such as its C string or its unqualified form, depend
+ * on nothing but the type string itself and are needed over and over again
+ * for the same few types.   Each distinct type string is given one node, a
+ * hash on which these forms are remembered the first time they are made.
+ * SwigType_getform() returns a new copy of a remembered form or NULL.
+ *
+ * Forms that depend on typedefs or on the current scope must not be
+ * remembered here.  Nor are the forms that are cheaper to rebuild than to
+ * look up and copy, such as the lists made by SwigType_split() and
+ * SwigType_parmlist(), or the strings made by SwigType_base() and
+ * SwigType_prefix().
+ * ----------------------------------------------------------------------------- */
+
+static Hash *type_nodes = 0;
+
+String *SwigType_getform(const SwigType *t, const char *form) {
+  Hash *node;
+  String *r;
+  if (!type_nodes)
+    return 0;
+  node = Getattr(type_nodes, t);
+  if (!node)
+    return 0;
+  r = Getattr(node, form);
+  return r ? Copy(r) : 0;
+}
+
+void SwigType_setform(const SwigType *t, const char *form, const String *value) {
+  Hash *node;
+  String *v;
+  if (!type_nodes)
+    type_nodes = NewHash();
+  node = Getattr(type_nodes, t);
+  if (!node) {
+    String *key = NewString(t);
+    node = NewHash();
+    Setattr(type_nodes, key, node);
+    Delete(node);
+    Delete(key);
+  }
+  v = Copy(value);
+  Setattr(node, form, v);
+  Delete(v);
+}
+
 /* The next few functions are utility functions used in the construction and 
    management of types */
 
@@ -1063,16 +1112,13 @@ String *SwigType_prefix(const SwigType *t) {
  * ----------------------------------------------------------------------------- */
 
 SwigType *SwigType_strip_qualifiers(SwigType *t) {
-  static Hash *memoize_stripped = 0;
   SwigType *r;
   List *l;
   Iterator ei;
 
-  if (!memoize_stripped)
-    memoize_stripped = NewHash();
-  r = Getattr(memoize_stripped, t);
+  r = SwigType_getform(t, "stripped");
   if (r)
-    return Copy(r);
+    return r;
 
   l = SwigType_split(t);
   r = NewStringEmpty();
@@ -1083,13 +1129,6 @@ SwigType *SwigType_strip_qualifiers(SwigType *t) {
     Append(r, ei.item);
   }
   Delete(l);
-  {
-    String *key, *value;
-    key = Copy(t);
-    value = Copy(r);
-    Setattr(memoize_stripped, key, value);
-    Delete(key);
-    Delete(value);
-  }
+  SwigType_setform(t, "stripped", r);
   return r;
 }
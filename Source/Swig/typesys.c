@@ -104,9 +104,19 @@ static Hash *scopes = 0;	/* Hash table containing fully qualified scopes */
 
 /* Performance optimization */
 #define SWIG_TYPEDEF_RESOLVE_CACHE
-static Hash *typedef_resolve_cache = 0;
-static Hash *typedef_all_cache = 0;
-static Hash *typedef_qualified_cache = 0;
+
+/* The results of SwigType_typedef_resolve(), SwigType_typedef_resolve_all()
+   and SwigType_typedef_qualified() are cached per scope.  Each entry records
+   the epoch it was made in and the names it looked up, and is used only if
+   none of these names has been defined since and the scope inheritance has
+   not changed.  Results that depend on the symbol tables look up the name
+   TYPEDEF_SYMTAB_DEP, which changes whenever the type system or the current
+   scope changes. */
+#define TYPEDEF_SYMTAB_DEP " symtab"
+static int typedef_epoch = 0;	/* Count of changes to the type system          */
+static int typedef_scope_epoch = 0;	/* Epoch of the last change to scope inheritance */
+static Hash *typedef_name_epoch = 0;	/* Epoch of the last definition of each name    */
+static Hash *typedef_deps = 0;	/* Names looked up by the result being computed */
 
 static Typetab *SwigType_find_scope(Typetab *s, String *nameprefix);
 
@@ -130,9 +140,111 @@ int Swig_value_wrapper_mode(int mode) {
 
 
 static void flush_cache() {
-  typedef_resolve_cache = 0;
-  typedef_all_cache = 0;
-  typedef_qualified_cache = 0;
+  typedef_epoch++;
+  SetInt(typedef_name_epoch, TYPEDEF_SYMTAB_DEP, typedef_epoch);
+}
+
+/* A typedef or scope has been defined under the given name */
+static void typedef_name_changed(const_String_or_char_ptr name) {
+  String *key = NewString(name);
+  typedef_epoch++;
+  SetInt(typedef_name_epoch, key, typedef_epoch);
+  Delete(key);
+}
+
+/* The inheritance of a scope has changed */
+static void typedef_scope_changed() {
+  typedef_epoch++;
+  typedef_scope_epoch = typedef_epoch;
+}
+
+/* The result being computed depends on the definition of name */
+static void typedef_depends(const_String_or_char_ptr name) {
+  if (typedef_deps && !Getattr(typedef_deps, name)) {
+    String *key = NewString(name);
+    Setattr(typedef_deps, key, typedef_name_epoch);
+    Delete(key);
+  }
+}
+
+static void typedef_depends_all(Hash *deps) {
+  if (typedef_deps) {
+    Iterator ki;
+    for (ki = First(deps); ki.key; ki = Next(ki)) {
+      typedef_depends(ki.key);
+    }
+  }
+}
+
+/* A cached result, with the names it depends on */
+typedef struct {
+  SwigType *result;		/* Cached result, 0 if none */
+  Typetab *scope;		/* Scope the type was resolved in */
+  Hash *deps;			/* Names looked up to compute the result */
+  int epoch;			/* Epoch the result was computed in */
+  int checked;			/* Epoch the entry was last found valid in */
+} TypedefCacheEntry;
+
+static void typedef_cache_free(void *ptr) {
+  TypedefCacheEntry *entry = (TypedefCacheEntry *) ptr;
+  Delete(entry->result);
+  Delete(entry->deps);
+  free(entry);
+}
+
+/* Returns the valid cache entry for t in the current scope, if any */
+static TypedefCacheEntry *typedef_cache_get(const char *cachename, const SwigType *t) {
+  Hash *cache = Getattr(current_scope, cachename);
+  DOH *v = cache ? Getattr(cache, t) : 0;
+  TypedefCacheEntry *entry;
+  if (!v)
+    return 0;
+  entry = (TypedefCacheEntry *) Data(v);
+  /* Nothing can have changed since the entry was last checked */
+  if (entry->checked != typedef_epoch) {
+    Iterator ki;
+    if (entry->epoch < typedef_scope_epoch)
+      return 0;
+    for (ki = First(entry->deps); ki.key; ki = Next(ki)) {
+      if (GetInt(typedef_name_epoch, ki.key) > entry->epoch)
+	return 0;
+    }
+    entry->checked = typedef_epoch;
+  }
+  typedef_depends_all(entry->deps);
+  return entry;
+}
+
+/* Starts recording the names looked up for a new cache entry */
+static Hash *typedef_cache_begin() {
+  Hash *saved = typedef_deps;
+  typedef_deps = NewHash();
+  return saved;
+}
+
+/* Stores the result r computed for t in the current scope */
+static void typedef_cache_end(const char *cachename, const SwigType *t, const SwigType *r, Typetab *scope, Hash *saved) {
+  Hash *cache = Getattr(current_scope, cachename);
+  TypedefCacheEntry *entry = (TypedefCacheEntry *) malloc(sizeof(TypedefCacheEntry));
+  String *key = NewString(t);
+  DOH *v;
+  if (!cache) {
+    cache = NewHash();
+    Setattr(current_scope, cachename, cache);
+    Delete(cache);
+  }
+  entry->result = r ? Copy(r) : 0;
+  entry->scope = scope;
+  entry->deps = typedef_deps;
+  entry->epoch = typedef_epoch;
+  entry->checked = typedef_epoch;
+  v = NewVoid(entry, typedef_cache_free);
+  Setattr(cache, key, v);
+  Delete(key);
+  Delete(v);
+
+  typedef_deps = saved;
+  typedef_depends_all(entry->deps);
 }
 
 /* Initialize the scoping system */
@@ -153,6 +265,10 @@ void SwigType_typesystem_init() {
   current_symtab = 0;
   scopes = NewHash();
   Setattr(scopes, "", current_scope);
+
+  if (!typedef_name_epoch)
+    typedef_name_epoch = NewHash();
+  typedef_scope_changed();
 }
 
 
@@ -182,6 +298,7 @@ int SwigType_typedef(SwigType *type, const_String_or_char_ptr name) {
     }
   }
   Setattr(current_typetab, name, type);
+  typedef_name_changed(name);
   flush_cache();
   return 0;
 }
@@ -201,6 +318,7 @@ int SwigType_typedef_class(const_String_or_char_ptr name) {
   cname = NewString(name);
   Setmeta(cname, "class", "1");
   Setattr(current_typetab, cname, cname);
+  typedef_name_changed(cname);
   Delete(cname);
   flush_cache();
   return 0;
@@ -250,6 +368,7 @@ void SwigType_new_scope(const_String_or_char_ptr name) {
   qname = SwigType_scope_name(s);
   Setattr(scopes, qname, s);
   Setattr(s, "qname", qname);
+  typedef_name_changed(qname);
   Delete(qname);
 
   current_scope = s;
@@ -283,6 +402,7 @@ void SwigType_inherit_scope(Typetab *scope) {
       return;
   }
   Append(inherits, scope);
+  typedef_scope_changed();
 }
 
 /* -----------------------------------------------------------------------------
@@ -300,6 +420,7 @@ void SwigType_scope_alias(String *aliasname, Typetab *ttab) {
   }
   Append(q, aliasname);
   Setattr(scopes, q, ttab);
+  typedef_name_changed(q);
   flush_cache();
 }
 
@@ -329,6 +450,7 @@ void SwigType_using_scope(Typetab *scope) {
     }
     Append(ulist, scope);
   }
+  typedef_scope_changed();
   flush_cache();
 }
 
@@ -377,6 +499,7 @@ Typetab *SwigType_set_scope(Typetab *t) {
 void SwigType_attach_symtab(Symtab *sym) {
   Setattr(current_scope, "symtab", sym);
   current_symtab = sym;
+  flush_cache();
 }
 
 /* -----------------------------------------------------------------------------
@@ -431,6 +554,7 @@ static Typetab *SwigType_find_scope(Typetab *s, String *nameprefix) {
     } else {
       full = NewString(nameprefix);
     }
+    typedef_depends(full);
     if (Getattr(scopes, full)) {
       s = Getattr(scopes, full);
     } else {
@@ -485,23 +609,33 @@ static Typetab *resolved_scope = 0;
 
 /* Internal function */
 
+/* The mark of a scope is set while it is searched. A class inherits the
+   scopes of all its bases, direct or not, so in a deep hierarchy the same
+   scope can be reached through many paths. To search it only once, the mark
+   is left set on a scope searched in vain, and these scopes are kept in
+   typedef_resolve_failed until the end of the typedef_resolve(). */
+static List *typedef_resolve_failed = 0;
+
 static SwigType *_typedef_resolve(Typetab *s, String *base, int look_parent) {
   Hash *ttab;
   SwigType *type = 0;
   List *inherit;
   Typetab *parent;
+  int marked;
 
   /* if (!s) return 0; *//* now is checked bellow */
   /* Printf(stdout,"Typetab %s : %s\n", Getattr(s,"name"), base);  */
 
-  if (!Getmark(s)) {
+  /* The scopes searched with look_parent set are on the parent chain of
+     the first one, so a mark can only have been left by a search in vain */
+  marked = Getmark(s);
+  if (!marked || look_parent) {
     Setmark(s, 1);
 
     ttab = Getattr(s, "typetab");
     type = Getattr(ttab, base);
     if (type) {
       resolved_scope = s;
-      Setmark(s, 0);
     } else {
       /* Hmmm. Not found in my scope.  It could be in an inherited scope */
       inherit = Getattr(s, "inherit");
@@ -511,7 +645,6 @@ static SwigType *_typedef_resolve(Typetab *s, String *base, int look_parent) {
 	for (i = 0; i < len; i++) {
 	  type = _typedef_resolve(Getitem(inherit, i), base, 0);
 	  if (type) {
-	    Setmark(s, 0);
 	    break;
 	  }
 	}
@@ -523,14 +656,31 @@ static SwigType *_typedef_resolve(Typetab *s, String *base, int look_parent) {
 	  type = parent ? _typedef_resolve(parent, base, 1) : 0;
 	}
       }
-      Setmark(s, 0);
+    }
+    if (type) {
+      Setmark(s, marked);
+    } else if (!marked) {
+      Append(typedef_resolve_failed, s);
     }
   }
   return type;
 }
 
 static SwigType *typedef_resolve(Typetab *s, String *base) {
-  return _typedef_resolve(s, base, 1);
+  SwigType *type;
+  int i, len;
+  if (!typedef_resolve_failed)
+    typedef_resolve_failed = NewList();
+  typedef_depends(base);
+  type = _typedef_resolve(s, base, 1);
+  len = Len(typedef_resolve_failed);
+  if (len) {
+    for (i = 0; i < len; i++) {
+      Setmark(Getitem(typedef_resolve_failed, i), 0);
+    }
+    Clear(typedef_resolve_failed);
+  }
+  return type;
 }
 
 
@@ -548,6 +698,10 @@ SwigType *SwigType_typedef_resolve(const SwigType *t) {
   String *namebase = 0;
   String *nameprefix = 0;
   int newtype = 0;
+#ifdef SWIG_TYPEDEF_RESOLVE_CACHE
+  TypedefCacheEntry *entry;
+  Hash *saved_deps;
+#endif
 
   /*
      if (!noscope) {
@@ -558,14 +712,12 @@ SwigType *SwigType_typedef_resolve(const SwigType *t) {
   resolved_scope = 0;
 
 #ifdef SWIG_TYPEDEF_RESOLVE_CACHE
-  if (!typedef_resolve_cache) {
-    typedef_resolve_cache = NewHash();
-  }
-  r = Getattr(typedef_resolve_cache, t);
-  if (r) {
-    resolved_scope = Getmeta(r, "scope");
-    return Copy(r);
+  entry = typedef_cache_get("cache:resolve", t);
+  if (entry) {
+    resolved_scope = entry->scope;
+    return entry->result ? Copy(entry->result) : 0;
   }
+  saved_deps = typedef_cache_begin();
 #endif
 
   base = SwigType_base(t);
@@ -584,6 +736,7 @@ SwigType *SwigType_typedef_resolve(const SwigType *t) {
       Delitem(base, 0);
     }
     /* Do a quick check in the local scope */
+    typedef_depends(base);
     type = Getattr(ttab, base);
     if (type) {
       resolved_scope = s;
@@ -780,18 +933,7 @@ SwigType *SwigType_typedef_resolve(const SwigType *t) {
 
 return_result:
 #ifdef SWIG_TYPEDEF_RESOLVE_CACHE
-  {
-    String *key = NewString(t);
-    if (r) {
-      SwigType *r1;
-      Setattr(typedef_resolve_cache, key, r);
-      Setmeta(r, "scope", resolved_scope);
-      r1 = Copy(r);
-      Delete(r);
-      r = r1;
-    }
-    Delete(key);
-  }
+  typedef_cache_end("cache:resolve", t, r, resolved_scope, saved_deps);
 #endif
   return r;
 }
@@ -805,15 +947,15 @@ return_result:
 SwigType *SwigType_typedef_resolve_all(SwigType *t) {
   SwigType *n;
   SwigType *r;
+  TypedefCacheEntry *entry;
+  Hash *saved_deps;
 
   /* Check to see if the typedef resolve has been done before by checking the cache */
-  if (!typedef_all_cache) {
-    typedef_all_cache = NewHash();
-  }
-  r = Getattr(typedef_all_cache, t);
-  if (r) {
-    return Copy(r);
+  entry = typedef_cache_get("cache:all", t);
+  if (entry) {
+    return Copy(entry->result);
   }
+  saved_deps = typedef_cache_begin();
 
   /* Recursively resolve the typedef */
   r = NewString(t);
@@ -823,14 +965,7 @@ SwigType *SwigType_typedef_resolve_all(SwigType *t) {
   }
 
   /* Add the typedef to the cache for next time it is looked up */
-  {
-    String *key;
-    SwigType *rr = Copy(r);
-    key = NewString(t);
-    Setattr(typedef_all_cache, key, rr);
-    Delete(key);
-    Delete(rr);
-  }
+  typedef_cache_end("cache:all", t, r, 0, saved_deps);
   return r;
 }
 
@@ -847,18 +982,18 @@ SwigType *SwigType_typedef_qualified(SwigType *t) {
   List *elements;
   String *result;
   int i, len;
+  TypedefCacheEntry *entry;
+  Hash *saved_deps;
 
   if (strncmp(Char(t), "::", 2) == 0) {
     return Copy(t);
   }
 
-  if (!typedef_qualified_cache)
-    typedef_qualified_cache = NewHash();
-  result = Getattr(typedef_qualified_cache, t);
-  if (result) {
-    String *rc = Copy(result);
-    return rc;
+  entry = typedef_cache_get("cache:qualified", t);
+  if (entry) {
+    return Copy(entry->result);
   }
+  saved_deps = typedef_cache_begin();
 
   result = NewStringEmpty();
   elements = SwigType_split(t);
@@ -909,6 +1044,7 @@ SwigType *SwigType_typedef_qualified(SwigType *t) {
 		Append(qs, "::");
 	      }
 	      Append(qs, e);
+	      typedef_depends(qs);
 	      if (Getattr(scopes, qs)) {
 		Clear(e);
 		Append(e, qs);
@@ -931,6 +1067,7 @@ SwigType *SwigType_typedef_qualified(SwigType *t) {
 	Iterator pi;
 	Parm *p;
 	List *parms;
+	typedef_depends(TYPEDEF_SYMTAB_DEP);
 	ty = Swig_symbol_template_deftype(e, current_symtab);
 	e = ty;
 	parms = SwigType_parmlist(e);
@@ -1026,6 +1163,7 @@ SwigType *SwigType_typedef_qualified(SwigType *t) {
     } else if (SwigType_isarray(e)) {
       String *ndim;
       String *dim = SwigType_parm(e);
+      typedef_depends(TYPEDEF_SYMTAB_DEP);
       ndim = Swig_symbol_string_qualify(dim, 0);
       Printf(result, "a(%s).", ndim);
       Delete(dim);
@@ -1035,14 +1173,7 @@ SwigType *SwigType_typedef_qualified(SwigType *t) {
     }
   }
   Delete(elements);
-  {
-    String *key, *cresult;
-    key = NewString(t);
-    cresult = NewString(result);
-    Setattr(typedef_qualified_cache, key, cresult);
-    Delete(key);
-    Delete(cresult);
-  }
+  typedef_cache_end("cache:qualified", t, result, 0, saved_deps);
   return result;
 }
 
@@ -1099,6 +1230,7 @@ int SwigType_typedef_using(const_String_or_char_ptr name) {
 
   /* We set up a typedef  B --> A::B */
   Setattr(current_typetab, base, name);
+  typedef_name_changed(base);
 
   /* Find the scope name where the symbol is defined */
   td = SwigType_typedef_resolve(name);
@@ -1125,6 +1257,7 @@ int SwigType_typedef_using(const_String_or_char_ptr name) {
       Hash *ttab = Getattr(s, "typetab");
       if (!Getattr(ttab, base) && defined_name) {
 	Setattr(ttab, base, defined_name);
+	typedef_name_changed(base);
       }
     }
   }
@@ -2061,7 +2194,7 @@ void SwigType_emit_type_table(File *f_forward, File *f_table) {
   Printf(f_table, "\n/* -------- TYPE CONVERSION AND EQUIVALENCE RULES (END) -------- */\n\n");
 
   Printf(f_forward, "static swig_type_info *swig_types[%d];\n", i + 1);
-  Printf(f_forward, "static swig_module_info swig_module = {swig_types, %d, 0, 0, 0, 0};\n", i);
+  Printf(f_forward, "static swig_module_info swig_module = {swig_types, %d, 0, 0, 0, 0, 0};\n", i);
   Printf(f_forward, "#define SWIG_TypeQuery(name) SWIG_TypeQueryModule(&swig_module, &swig_module, name)\n");
   Printf(f_forward, "#define SWIG_MangledTypeQuery(name) SWIG_MangledTypeQueryModule(&swig_module, &swig_module, name)\n");
   Printf(f_forward, "\n/* -------- TYPES TABLE (END) -------- */\n\n");
@@ -0,0 +1,32 @@
+/* -----------------------------------------------------------------------------
+ * preprocessor.i
+ *
+ * Input for 'make benchmark-preprocessor', which times 'swig -python -c++ -E'
+ * on the Python library and the STL containers.  Most of the work done is
+ * the expansion of the %define macros in Lib/python and Lib/std.
+ * ----------------------------------------------------------------------------- */
+
+%module preprocessor_benchmark
+
+%include <std_string.i>
+%include <std_wstring.i>
+%include <std_complex.i>
+%include <std_pair.i>
+%include <std_vector.i>
+%include <std_list.i>
+%include <std_deque.i>
+%include <std_set.i>
+%include <std_multiset.i>
+%include <std_map.i>
+%include <std_multimap.i>
+
+%template(VectorInt) std::vector<int>;
+%template(VectorDouble) std::vector<double>;
+%template(VectorString) std::vector<std::string>;
+%template(ListInt) std::list<int>;
+%template(DequeDouble) std::deque<double>;
+%template(SetString) std::set<std::string>;
+%template(MultiSetInt) std::multiset<int>;
+%template(PairIntDouble) std::pair<int, double>;
+%template(MapStringInt) std::map<std::string, int>;
+%template(MultiMapIntString) std::multimap<int, std::string>;